@@ -0,0 +1,521 @@
+#include <QtTest>
+#include <QFont>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QTemporaryDir>
+#include <random>
+#include <vector>
+
+#include "ClockFormatter.h"
+#include "ClockLayout.h"
+#include "ClockRenderer.h"
+#include "Config.h"
+#include "ExposureMap.h"
+#include "KDEClockConfig.h"
+#include "Placement.h"
+#include "PlasmaConfigIndex.h"
+
+// Synthetic appletsrc of at least targetBytes: one panel with a digital
+// clock, then desktop containments with configured applets until the size
+// is reached, like a long-lived desktop's config
+static QByteArray appletsrc(int targetBytes)
+{
+    QByteArray data;
+    data += "[ActionPlugins][0]\nMiddleButton;NoModifier=org.kde.paste\n\n";
+    data += "[Containments][1]\nactivityId=\nformfactor=2\nimmutability=1\n"
+            "lastScreen=0\nlocation=4\nplugin=org.kde.panel\nwallpaperplugin=org.kde.image\n\n";
+    data += "[Containments][1][Applets][2]\nimmutability=1\nplugin=org.kde.plasma.kickoff\n\n";
+    data += "[Containments][1][Applets][3]\nimmutability=1\nplugin=org.kde.plasma.digitalclock\n\n";
+    data += "[Containments][1][Applets][3][Configuration][Appearance]\n"
+            "dateFormat=isoDate\nshowDate=true\nshowSeconds=2\nuse24hFormat=2\n\n";
+
+    for (int containment = 100; data.size() < targetBytes; containment++) {
+        const QByteArray id = QByteArray::number(containment);
+        data += "[Containments][" + id + "]\nactivityId=" + QByteArray(36, 'a') +
+                "\nformfactor=0\nimmutability=1\nlastScreen=" + QByteArray::number(containment % 3) +
+                "\nlocation=0\nplugin=org.kde.plasma.folder\nwallpaperplugin=org.kde.image\n\n";
+        data += "[Containments][" + id + "][Wallpaper][org.kde.image][General]\n"
+                "Image=/usr/share/wallpapers/Next/\nSlidePaths=/usr/share/wallpapers/\n\n";
+
+        for (int applet = 0; applet < 8; applet++) {
+            const QByteArray appletId = QByteArray::number(containment * 100 + applet);
+            const QByteArray group = "[Containments][" + id + "][Applets][" + appletId + "]";
+            data += group + "\nimmutability=1\nplugin=org.kde.plasma.notes\n\n";
+            data += group + "[Configuration][General]\nnoteId=" + QByteArray(36, 'b') +
+                    "\nfontSize=10\ncolor=yellow\n\n";
+            data += group + "[Configuration][ConfigDialog]\nDialogHeight=540\nDialogWidth=720\n\n";
+        }
+    }
+    return data;
+}
+
+static QByteArray plasmashellrc()
+{
+    return "[PlasmaViews][Panel 1]\nfloating=1\n\n"
+           "[PlasmaViews][Panel 1][Defaults]\nthickness=44\n\n"
+           "[ScreenConnectors]\n0=DP-1\n1=HDMI-A-1\n";
+}
+
+// The font sizing ClockLayout::compute replaced: shrink by 10% and measure
+// again until the samples fit, up to 20 QFont/QFontMetrics per line. Kept
+// as the baseline for the layout cases.
+static ClockLayout probeLayout(const KDEClockConfig& clock, const KDEPanelConfig& panel)
+{
+    const int thickness = panel.thickness;
+    const QString timeSample = ClockLayout::timeSample(clock);
+    const QString dateSample = ClockLayout::dateSample(clock);
+
+    ClockLayout layout;
+    if (panel.location == 5 || panel.location == 6) {
+        const int availableWidth = thickness - 4;
+
+        double timeRatio = 1.0;
+        for (int attempt = 0; attempt < 20; attempt++) {
+            layout.timeFontSize = static_cast<int>(thickness * timeRatio);
+            QFont font(Config::FontFamily);
+            font.setPixelSize(layout.timeFontSize);
+            QFontMetrics fm(font);
+            if (fm.horizontalAdvance(timeSample) <= availableWidth) {
+                layout.timeCapHeight = fm.capHeight();
+                break;
+            }
+            timeRatio *= 0.9;
+        }
+
+        if (clock.showDate) {
+            double dateRatio = 1.0;
+            for (int attempt = 0; attempt < 20; attempt++) {
+                layout.dateFontSize = static_cast<int>(thickness * dateRatio);
+                QFont font(Config::FontFamily);
+                font.setPixelSize(layout.dateFontSize);
+                QFontMetrics fm(font);
+                if (fm.horizontalAdvance(dateSample) <= availableWidth) {
+                    layout.dateCapHeight = fm.capHeight();
+                    break;
+                }
+                dateRatio *= 0.9;
+            }
+        }
+    } else {
+        double timeRatio = 0.56;
+        for (int attempt = 0; attempt < 20; attempt++) {
+            if (clock.showDate) {
+                layout.timeFontSize = static_cast<int>(thickness * timeRatio);
+                layout.dateFontSize = static_cast<int>(layout.timeFontSize * 0.8);
+            } else {
+                layout.timeFontSize = static_cast<int>(thickness * 0.71);
+            }
+
+            QFont timeFont(Config::FontFamily);
+            timeFont.setPixelSize(layout.timeFontSize);
+            layout.timeCapHeight = QFontMetrics(timeFont).capHeight();
+
+            int totalHeight = layout.timeCapHeight + 2;
+            if (clock.showDate) {
+                QFont dateFont(Config::FontFamily);
+                dateFont.setPixelSize(layout.dateFontSize);
+                layout.dateCapHeight = QFontMetrics(dateFont).capHeight();
+                totalHeight += 4 + layout.dateCapHeight + 2;
+            }
+
+            if (totalHeight <= thickness) {
+                break;
+            }
+            timeRatio *= 0.9;
+        }
+    }
+
+    layout.timeFontSize = qMax(layout.timeFontSize, 8);
+    if (clock.showDate) {
+        layout.dateFontSize = qMax(layout.dateFontSize, 8);
+    }
+    return layout;
+}
+
+class ClockBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void parseIndex_data();
+    void parseIndex();
+
+    void clockConfig_data();
+    void clockConfig();
+    void panelConfig_data();
+    void panelConfig();
+
+    void layoutProbing_data();
+    void layoutProbing();
+    void layoutCompute_data();
+    void layoutCompute();
+    void layoutCached();
+    void layoutProbes();
+
+    void formatTime();
+    void formatDate();
+    void formatDateRollover();
+
+    void renderTick_data();
+    void renderTick();
+
+    void randomPosition();
+    void sequencePosition();
+    void bandProfile();
+    void leastWorn();
+
+private:
+    QByteArray fixture(const QString& name) const;
+
+    QTemporaryDir m_dir;
+};
+
+void ClockBench::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+
+    const QList<QPair<QString, int>> sizes = {
+        {"10k", 10 * 1024}, {"100k", 100 * 1024}, {"200k", 200 * 1024},
+        {"1m", 1024 * 1024}, {"10m", 10 * 1024 * 1024}
+    };
+    for (const auto& size : sizes) {
+        QFile file(m_dir.filePath("appletsrc-" + size.first));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(appletsrc(size.second));
+    }
+
+    QFile shell(m_dir.filePath("plasmashellrc"));
+    QVERIFY(shell.open(QIODevice::WriteOnly));
+    shell.write(plasmashellrc());
+
+    ExposureMap::setDirectory(m_dir.filePath("exposure"));
+}
+
+QByteArray ClockBench::fixture(const QString& name) const
+{
+    QFile file(m_dir.filePath(name));
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+void ClockBench::parseIndex_data()
+{
+    QTest::addColumn<QString>("file");
+    QTest::newRow("10k") << "appletsrc-10k";
+    QTest::newRow("100k") << "appletsrc-100k";
+    QTest::newRow("1m") << "appletsrc-1m";
+    QTest::newRow("10m") << "appletsrc-10m";
+}
+
+void ClockBench::parseIndex()
+{
+    QFETCH(QString, file);
+    const QByteArray data = fixture(file);
+    QVERIFY(!data.isEmpty());
+
+    // Tokenizing and indexing alone, without any lookups
+    PlasmaConfigIndex index;
+    QBENCHMARK {
+        index = PlasmaConfigIndex::fromData(data);
+    }
+    QVERIFY(index.hasGroup(PlasmaConfigIndex::groupKey({"Containments", "1"})));
+}
+
+void ClockBench::clockConfig_data()
+{
+    QTest::addColumn<QString>("file");
+    QTest::newRow("10k") << "appletsrc-10k";
+    QTest::newRow("200k") << "appletsrc-200k";
+    QTest::newRow("1m") << "appletsrc-1m";
+}
+
+void ClockBench::clockConfig()
+{
+    QFETCH(QString, file);
+    const QByteArray data = fixture(file);
+    QVERIFY(!data.isEmpty());
+
+    KDEClockConfig config;
+    QBENCHMARK {
+        config = KDEClockConfig::fromIndex(PlasmaConfigIndex::fromData(data));
+    }
+    QCOMPARE(config.showSeconds, 2);
+    QCOMPARE(config.dateFormat, QString("isoDate"));
+}
+
+void ClockBench::panelConfig_data()
+{
+    clockConfig_data();
+}
+
+void ClockBench::panelConfig()
+{
+    QFETCH(QString, file);
+    const QByteArray data = fixture(file);
+    const QByteArray shell = fixture("plasmashellrc");
+    QVERIFY(!data.isEmpty());
+
+    KDEPanelConfig config;
+    QBENCHMARK {
+        config = KDEPanelConfig::fromIndex(PlasmaConfigIndex::fromData(data),
+                                           PlasmaConfigIndex::fromData(shell));
+    }
+    QCOMPARE(config.location, 4);
+    QCOMPARE(config.thickness, 44);
+}
+
+void ClockBench::layoutCompute_data()
+{
+    QTest::addColumn<int>("location");
+    QTest::addColumn<int>("thickness");
+    QTest::addColumn<int>("showSeconds");
+    QTest::newRow("bottom-44") << 4 << 44 << 0;
+    QTest::newRow("bottom-44-seconds") << 4 << 44 << 2;
+    QTest::newRow("bottom-80") << 4 << 80 << 0;
+    QTest::newRow("left-64") << 5 << 64 << 0;
+}
+
+void ClockBench::layoutProbing_data()
+{
+    layoutCompute_data();
+}
+
+void ClockBench::layoutProbing()
+{
+    QFETCH(int, location);
+    QFETCH(int, thickness);
+    QFETCH(int, showSeconds);
+
+    KDEClockConfig clock;
+    clock.showSeconds = showSeconds;
+    KDEPanelConfig panel;
+    panel.location = location;
+    panel.thickness = thickness;
+
+    // Before: iterative probing, redone on every rebuild
+    ClockLayout layout;
+    QBENCHMARK {
+        layout = probeLayout(clock, panel);
+    }
+    QVERIFY(layout.isValid());
+}
+
+void ClockBench::layoutCompute()
+{
+    QFETCH(int, location);
+    QFETCH(int, thickness);
+    QFETCH(int, showSeconds);
+
+    KDEClockConfig clock;
+    clock.showSeconds = showSeconds;
+    KDEPanelConfig panel;
+    panel.location = location;
+    panel.thickness = thickness;
+
+    // After: sizes solved from reference metrics; every iteration starts
+    // with an empty cache (compare layoutProbing and layoutCached)
+    ClockLayout layout;
+    QBENCHMARK {
+        ClockLayout::clearCache();
+        layout = ClockLayout::compute(clock, panel, 1.0);
+    }
+    QVERIFY(layout.isValid());
+}
+
+void ClockBench::layoutCached()
+{
+    const KDEClockConfig clock;
+    const KDEPanelConfig panel;
+    ClockLayout::compute(clock, panel, 1.0);
+
+    ClockLayout layout;
+    QBENCHMARK {
+        layout = ClockLayout::compute(clock, panel, 1.0);
+    }
+    QVERIFY(layout.isValid());
+}
+
+void ClockBench::layoutProbes()
+{
+    // Every panel thickness Plasma allows, each orientation and format,
+    // each from an empty cache; reports the most fonts measured for one
+    // layout, which the size search keeps logarithmic
+    QList<QPair<KDEClockConfig, KDEPanelConfig>> configs;
+    for (int location : {4, 5}) {
+        for (int thickness = 16; thickness <= 200; thickness++) {
+            for (int format = 0; format < 8; format++) {
+                KDEClockConfig clock;
+                clock.use24hFormat = (format & 1) ? 2 : 0;
+                clock.showSeconds = (format & 2) ? 2 : 0;
+                clock.showDate = format & 4;
+                KDEPanelConfig panel;
+                panel.location = location;
+                panel.thickness = thickness;
+                configs.append({clock, panel});
+            }
+        }
+    }
+
+    quint64 worst = 0;
+    QBENCHMARK {
+        for (const auto& config : std::as_const(configs)) {
+            ClockLayout::clearCache();
+            const quint64 before = ClockLayout::fontProbes();
+            const ClockLayout layout = ClockLayout::compute(config.first, config.second, 1.0);
+            worst = qMax(worst, ClockLayout::fontProbes() - before);
+            QVERIFY(layout.isValid());
+        }
+    }
+
+    qInfo("worst case: %llu fonts measured for one layout", worst);
+}
+
+void ClockBench::formatTime()
+{
+    KDEClockConfig config;
+    config.showSeconds = 2;
+    const ClockFormatter formatter(config);
+    const QTime time(13, 37, 42);
+
+    QString text;
+    QBENCHMARK {
+        text = formatter.formatTime(time);
+    }
+    QVERIFY(!text.isEmpty());
+}
+
+void ClockBench::formatDate()
+{
+    ClockFormatter formatter;
+    const QDate date(2026, 3, 14);
+
+    // Same day on every tick, the cached text is returned
+    QString text;
+    QBENCHMARK {
+        text = formatter.formatDate(date);
+    }
+    QVERIFY(!text.isEmpty());
+}
+
+void ClockBench::formatDateRollover()
+{
+    ClockFormatter formatter;
+    QDate date(2026, 3, 14);
+
+    QString text;
+    QBENCHMARK {
+        date = date.addDays(1);
+        text = formatter.formatDate(date);
+    }
+    QVERIFY(!text.isEmpty());
+}
+
+void ClockBench::renderTick_data()
+{
+    QTest::addColumn<bool>("fullRepaint");
+
+    QTest::newRow("damaged cells") << false;
+    QTest::newRow("whole surface") << true;
+}
+
+void ClockBench::renderTick()
+{
+    QFETCH(bool, fullRepaint);
+
+    KDEClockConfig clock;
+    clock.showSeconds = 2;
+    const ClockLayout layout = ClockLayout::compute(clock, KDEPanelConfig(), 1.0);
+    const ClockFormatter formatter(clock);
+
+    ClockRenderer renderer;
+    renderer.setup(layout, clock, 1.0, QColor(Config::FontColor));
+    const QRect surface(QPoint(0, 0), renderer.size());
+    QImage image(renderer.size(), QImage::Format_ARGB32_Premultiplied);
+
+    // A minute of seconds ticks, painted the way a surface paints them
+    QStringList texts;
+    for (int second = 0; second < 60; ++second) {
+        texts.append(formatter.formatTime(QTime(13, 37, second)));
+    }
+    renderer.setTime(texts.last());
+
+    int tick = 0;
+    quint64 pixels = 0;
+    QBENCHMARK {
+        QRegion damage = renderer.setTime(texts.at(tick % texts.size()));
+        if (fullRepaint) {
+            damage = surface;
+        }
+
+        QPainter painter(&image);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        for (const QRect& rect : damage) {
+            painter.fillRect(rect, Qt::transparent);
+            pixels += quint64(rect.width()) * rect.height();
+        }
+        painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+        renderer.paint(painter, damage);
+        tick++;
+    }
+    QVERIFY(tick > 0);
+
+    // PixelsPainted per tick, next to the time per tick reported above
+    qInfo("%llu of %d pixels per tick", pixels / tick, surface.width() * surface.height());
+}
+
+void ClockBench::randomPosition()
+{
+    std::mt19937 rng(1);
+    int pos = 0;
+    QBENCHMARK {
+        pos = Placement::random(rng, 20, 1800);
+    }
+    QVERIFY(pos >= 20 && pos <= 1800);
+}
+
+void ClockBench::sequencePosition()
+{
+    double phase = 0.5;
+    int pos = 0;
+    QBENCHMARK {
+        pos = Placement::sequence(phase, 20, 1800);
+    }
+    QVERIFY(pos >= 20 && pos <= 1800);
+}
+
+void ClockBench::bandProfile()
+{
+    ExposureMap exposure;
+    QVERIFY(exposure.open("bench-profile", QSize(1920, 44)));
+    QImage mask(100, 30, QImage::Format_Alpha8);
+    mask.fill(200);
+    for (int x = 0; x < 1800; x += 37) {
+        exposure.add(mask, QPoint(x, 7), 30);
+    }
+
+    std::vector<quint32> profile;
+    QBENCHMARK {
+        profile = Placement::bandProfile(exposure, false, 7, 37);
+    }
+    QCOMPARE(int(profile.size()), 1920);
+}
+
+void ClockBench::leastWorn()
+{
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<quint32> wear(0, 100000);
+    std::vector<quint32> profile(1920);
+    for (quint32& cell : profile) {
+        cell = wear(rng);
+    }
+
+    int pos = 0;
+    QBENCHMARK {
+        pos = Placement::leastWorn(profile, 100, 20, 1800);
+    }
+    QVERIFY(pos >= 20 && pos <= 1800);
+}
+
+QTEST_MAIN(ClockBench)
+#include "ClockBench.moc"
@@ -0,0 +1,101 @@
+#include "ClockChangeNotifier.h"
+#include "Wakeups.h"
+#include <QFileInfo>
+#include <QSocketNotifier>
+#include <QDebug>
+
+#include <ctime>
+#include <limits>
+
+#ifdef Q_OS_LINUX
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+static const char LocalTimePath[] = "/etc/localtime";
+
+ClockChangeNotifier::ClockChangeNotifier(QObject *parent)
+    : QObject(parent)
+    , m_timerFd(-1)
+    , m_notifier(nullptr)
+    , m_localTime(localTimeTarget())
+{
+#ifdef Q_OS_LINUX
+    m_timerFd = timerfd_create(CLOCK_REALTIME, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (m_timerFd >= 0 && armTimerFd()) {
+        m_notifier = new QSocketNotifier(m_timerFd, QSocketNotifier::Read, this);
+        connect(m_notifier, &QSocketNotifier::activated,
+                this, &ClockChangeNotifier::onTimerFdActivated);
+    } else {
+        qWarning("Could not set up clock change notification");
+    }
+#endif
+
+    // timedated replaces the /etc/localtime symlink, so watch the directory
+    m_zoneWatcher.addPath(QFileInfo(LocalTimePath).absolutePath());
+    connect(&m_zoneWatcher, &QFileSystemWatcher::directoryChanged,
+            this, &ClockChangeNotifier::onZoneInfoChanged);
+}
+
+ClockChangeNotifier::~ClockChangeNotifier()
+{
+#ifdef Q_OS_LINUX
+    if (m_timerFd >= 0) {
+        close(m_timerFd);
+    }
+#endif
+}
+
+bool ClockChangeNotifier::armTimerFd()
+{
+#ifdef Q_OS_LINUX
+    // An absolute timer that never expires; the kernel cancels it whenever
+    // CLOCK_REALTIME is set or jumps on resume, which wakes us up
+    struct itimerspec spec = {};
+    spec.it_value.tv_sec = std::numeric_limits<time_t>::max();
+    return timerfd_settime(m_timerFd, TFD_TIMER_ABSTIME | TFD_TIMER_CANCEL_ON_SET,
+                           &spec, nullptr) == 0;
+#else
+    return false;
+#endif
+}
+
+void ClockChangeNotifier::onTimerFdActivated()
+{
+    Wakeups::record();
+
+#ifdef Q_OS_LINUX
+    quint64 expirations;
+    const ssize_t n = read(m_timerFd, &expirations, sizeof(expirations));
+    if (n >= 0 || errno != ECANCELED) {
+        return;
+    }
+
+    armTimerFd();
+    qDebug() << "Wall clock changed";
+    emit clockChanged();
+#endif
+}
+
+void ClockChangeNotifier::onZoneInfoChanged()
+{
+    // Any change in /etc wakes us, not only the zone
+    Wakeups::record();
+
+    const QString target = localTimeTarget();
+    if (target == m_localTime) {
+        return;
+    }
+
+    m_localTime = target;
+    tzset();
+    qDebug() << "Time zone changed:" << target;
+    emit clockChanged();
+}
+
+QString ClockChangeNotifier::localTimeTarget()
+{
+    QFileInfo info(LocalTimePath);
+    return info.isSymLink() ? info.symLinkTarget() : info.absoluteFilePath();
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <QObject>
+#include <QFileSystemWatcher>
+#include <QString>
+
+class QSocketNotifier;
+
+// Reports wall-clock discontinuities without polling: clock steps (NTP,
+// manual changes) and resume from suspend through a timerfd armed with
+// TFD_TIMER_CANCEL_ON_SET, and timezone changes by watching /etc/localtime.
+
+class ClockChangeNotifier : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ClockChangeNotifier(QObject *parent = nullptr);
+    ~ClockChangeNotifier() override;
+
+signals:
+    void clockChanged();
+
+private slots:
+    void onTimerFdActivated();
+    void onZoneInfoChanged();
+
+private:
+    bool armTimerFd();
+    static QString localTimeTarget();
+
+    int m_timerFd;
+    QSocketNotifier* m_notifier;
+    QFileSystemWatcher m_zoneWatcher;
+    QString m_localTime;
+};
@@ -0,0 +1,731 @@
+#include "ClockController.h"
+#include "ClockOutput.h"
+#include "ClockSource.h"
+#include "ClockWidget.h"
+#include "ClockWindow.h"
+#include "Config.h"
+#include "ConfigAdaptor.h"
+#include "ConfigDiff.h"
+#include "ConfigLoader.h"
+#include "ConfigWatcher.h"
+#include "ControlAdaptor.h"
+#include "MetricsAdaptor.h"
+#include "PlasmaConfigSnapshot.h"
+#include "StartupCache.h"
+#include "TickScheduler.h"
+#include "TrayIconCache.h"
+#include "Wakeups.h"
+
+#include <QApplication>
+#include <QGuiApplication>
+#include <QDateTime>
+#include <QStandardPaths>
+#include <QDebug>
+#include <QIcon>
+#include <QAction>
+#include <QCursor>
+#include <QDBusConnection>
+#include <QDBusError>
+
+#include <LayerShellQt/Shell>
+
+ClockController::ClockController(Backend backend, bool allScreens, QObject *parent)
+    : QObject(parent)
+    , m_backend(backend)
+    , m_allScreens(allScreens)
+    , m_placement(ClockOutput::RandomPlacement)
+    , m_repositionIntervalMs(0)
+    , m_color(Config::FontColor)
+    , m_tickScheduler(nullptr)
+    , m_configWatcher(nullptr)
+    , m_configLoader(nullptr)
+    , m_trayIcon(nullptr)
+    , m_contextMenu(nullptr)
+    , m_toggleTrayAction(nullptr)
+    , m_settings("Ustek", "plasma-clock-oled")
+    , m_showTrayIcon(true)
+    , m_watchConfigFiles(true)
+    , m_trayAvailable(backend == WidgetBackend)
+    , m_configLoaded(false)
+    , m_firstFrameShown(false)
+    , m_layoutDevicePixelRatio(1.0)
+    , m_repaintsSkipped(0)
+{
+    m_startupTimer.start();
+
+    loadSettings();
+    if (m_watchConfigFiles) {
+        setupConfigWatcher();
+    } else {
+        qDebug() << "Not watching Plasma config files, settings come from D-Bus";
+    }
+
+    m_configLoader = new ConfigLoader(this);
+    connect(m_configLoader, &ConfigLoader::loaded, this, &ClockController::applyConfig);
+    // New mtimes would make the cache look stale on the next start
+    connect(m_configLoader, &ConfigLoader::unchanged, this, &ClockController::saveStartupCache);
+
+    // Warm start: reuse the cached config and layout while the config files
+    // are unchanged, otherwise read config off the GUI thread and build the
+    // clock once the first snapshot arrives (see applyConfig)
+    StartupCache::Entry cached;
+    if (StartupCache::load(QGuiApplication::primaryScreen()->devicePixelRatio(), cached)) {
+        qDebug() << "Using startup cache";
+        m_configLoaded = true;
+        m_kdeConfig = cached.clockConfig;
+        m_panelConfig = cached.panelConfig;
+        m_screenPanels = cached.screenPanels;
+        m_layout = cached.layout;
+        m_layoutDevicePixelRatio = cached.devicePixelRatio;
+        m_configLoader->setFingerprint(cached.fingerprint);
+        buildClock();
+    } else {
+        m_configLoader->request();
+    }
+
+    // Watch for screen changes (handles lock/unlock where outputs are removed/added)
+    connect(qGuiApp, &QGuiApplication::screenAdded,
+            this, &ClockController::onScreenAdded);
+    connect(qGuiApp, &QGuiApplication::screenRemoved,
+            this, &ClockController::onScreenRemoved);
+
+    // Also reached on logout, main turns SIGTERM into quit()
+    connect(qGuiApp, &QCoreApplication::aboutToQuit,
+            this, &ClockController::saveState);
+
+    setupDBus();
+}
+
+ClockController::~ClockController()
+{
+    qDeleteAll(m_outputs);
+    delete m_contextMenu;
+}
+
+ClockSurface* ClockController::createSurface()
+{
+    ClockSurface* surface;
+    if (m_backend == RasterBackend) {
+        surface = new ClockWindow();
+    } else {
+        surface = new ClockWidget();
+    }
+    surface->contextMenuRequested = [this]() { showContextMenu(); };
+    surface->firstFramePainted = [this]() { onFirstFrame(); };
+    if (m_trayAvailable) {
+        surface->paletteChanged = []() { TrayIconCache::instance()->paletteChanged(); };
+    }
+    return surface;
+}
+
+void ClockController::onFirstFrame()
+{
+    // Each output reports its first frame, the first one is the startup time
+    if (!m_firstFrameShown) {
+        m_firstFrameShown = true;
+        qDebug() << "Clock shown" << m_startupTimer.elapsed() << "ms after start on"
+                 << m_outputs.size() << "output(s), RSS" << residentSetKb() << "kB";
+    }
+
+    if (m_rebindTimer.isValid()) {
+        qDebug() << "Clock visible" << m_rebindTimer.elapsed() << "ms after screen added";
+        m_rebindTimer.invalidate();
+    }
+
+    // Tray icon and context menu are QWidget-based, the raster backend
+    // runs on a plain QGuiApplication without them. Otherwise they are
+    // kept off the path to the first frame: the tray is set up once that
+    // frame has been flushed, the menu on first use.
+    if (m_trayAvailable && !m_trayIcon) {
+        QTimer::singleShot(0, this, &ClockController::setupTrayIcon);
+    }
+}
+
+bool ClockController::isRealScreen(QScreen* screen)
+{
+    // Placeholder screens have an empty name and no real output behind them
+    return screen && !screen->name().isEmpty();
+}
+
+QList<QScreen*> ClockController::targetScreens() const
+{
+    if (!m_allScreens) {
+        return {QGuiApplication::primaryScreen()};
+    }
+
+    QList<QScreen*> screens;
+    for (QScreen* screen : QGuiApplication::screens()) {
+        if (isRealScreen(screen)) {
+            screens.append(screen);
+        }
+    }
+    return screens;
+}
+
+ClockOutput* ClockController::outputFor(QScreen* screen) const
+{
+    for (ClockOutput* output : m_outputs) {
+        if (output->screen() == screen) {
+            return output;
+        }
+    }
+    return nullptr;
+}
+
+KDEPanelConfig ClockController::panelFor(QScreen* screen) const
+{
+    // A single clock keeps to the panel hosting Plasma's own clock,
+    // per-screen clocks to the panel on their screen where there is one
+    if (!m_allScreens || !screen) {
+        return m_panelConfig;
+    }
+    return m_screenPanels.value(screen->name(), m_panelConfig);
+}
+
+ClockLayout ClockController::layoutFor(QScreen* screen, const KDEPanelConfig& panel) const
+{
+    // The shared layout is computed for the clock panel at the primary
+    // screen's scale
+    if (panel.thickness == m_panelConfig.thickness &&
+        panel.location == m_panelConfig.location &&
+        (!screen || qFuzzyCompare(screen->devicePixelRatio(), m_layoutDevicePixelRatio))) {
+        return m_layout;
+    }
+    const qreal dpr = screen ? screen->devicePixelRatio() : m_layoutDevicePixelRatio;
+    return ClockLayout::compute(m_kdeConfig, panel, dpr);
+}
+
+void ClockController::setupOutput(ClockOutput* output)
+{
+    const KDEPanelConfig panel = panelFor(output->screen());
+    output->setup(m_kdeConfig, panel, layoutFor(output->screen(), panel));
+}
+
+void ClockController::addOutput(QScreen* screen)
+{
+    qDebug() << "Adding clock on" << screen->name();
+
+    auto* output = new ClockOutput([this]() { return createSurface(); }, screen, this);
+    m_outputs.append(output);
+
+    output->setPlacement(static_cast<ClockOutput::Placement>(m_placement));
+    output->setRepositionInterval(m_repositionIntervalMs);
+    output->setColor(m_color);
+
+    setupOutput(output);
+    const QDateTime now = ClockSource::instance()->now();
+    output->setText(m_formatter.formatTime(now.time()),
+                    m_kdeConfig.showDate ? m_formatter.formatDate(now.date()) : QString());
+    output->show();
+}
+
+void ClockController::buildClock()
+{
+    m_formatter = ClockFormatter(m_kdeConfig);
+
+    qDebug() << "Time font:" << m_layout.timeFontSize << "Date font:" << m_layout.dateFontSize
+             << "panel:" << m_panelConfig.thickness
+             << ((m_panelConfig.location == 5 || m_panelConfig.location == 6)
+                     ? "(vertical)" : "(horizontal)");
+
+    for (QScreen* screen : targetScreens()) {
+        addOutput(screen);
+    }
+    setupTimers();
+}
+
+void ClockController::setupTimers()
+{
+    // Wake only when the displayed text can change; one tick drives every output
+    m_tickScheduler = new TickScheduler(this);
+    m_tickScheduler->setGranularity(m_formatter.showsSeconds() ? TickScheduler::Second
+                                                               : TickScheduler::Minute);
+    connect(m_tickScheduler, &TickScheduler::tick, this, &ClockController::updateTime);
+    m_tickScheduler->start();
+}
+
+void ClockController::updateTime()
+{
+    QDateTime now = ClockSource::instance()->now();
+
+    // Format once, then fan out to every output
+    const QString time = m_formatter.formatTime(now.time());
+    const QString date = m_kdeConfig.showDate ? m_formatter.formatDate(now.date()) : QString();
+
+    bool repainted = false;
+    for (ClockOutput* output : m_outputs) {
+        repainted |= output->setText(time, date);
+    }
+
+    if (!repainted) {
+        m_repaintsSkipped++;
+    }
+}
+
+void ClockController::setupConfigWatcher()
+{
+    m_configWatcher = new ConfigWatcher({PlasmaConfigSnapshot::appletsrcPath(),
+                                         PlasmaConfigSnapshot::plasmashellrcPath()}, this);
+
+    connect(m_configWatcher, &ConfigWatcher::changed,
+            this, &ClockController::reloadConfig);
+}
+
+void ClockController::reloadConfig()
+{
+    qDebug() << "Reloading panel configuration...";
+
+    // Keep rendering with the current config until the new snapshot is parsed
+    m_configLoader->request();
+}
+
+void ClockController::applyConfig(const PlasmaConfigSnapshot& snapshot)
+{
+    if (!m_configLoaded) {
+        m_configLoaded = true;
+        m_kdeConfig = snapshot.clockConfig();
+        m_panelConfig = snapshot.panelConfig();
+        m_screenPanels = snapshot.screenPanels();
+        m_layoutDevicePixelRatio = QGuiApplication::primaryScreen()->devicePixelRatio();
+        m_layout = ClockLayout::compute(m_kdeConfig, m_panelConfig, m_layoutDevicePixelRatio);
+
+        buildClock();
+        saveStartupCache(snapshot);
+        return;
+    }
+
+    // Clock format changes apply too, each at the cheapest level it needs
+    applyChanges(snapshot.clockConfig(), snapshot.panelConfig(), snapshot.screenPanels());
+    saveStartupCache(snapshot);
+}
+
+void ClockController::applyChanges(const KDEClockConfig& clock, const KDEPanelConfig& panel,
+                                   const QHash<QString, KDEPanelConfig>& screenPanels)
+{
+    const ConfigDiff::Changes clockChanges = ConfigDiff::clock(m_kdeConfig, clock);
+
+    // Outputs can have panels of their own, so they are diffed one by one
+    QHash<ClockOutput*, KDEPanelConfig> oldPanels;
+    for (ClockOutput* output : m_outputs) {
+        oldPanels.insert(output, panelFor(output->screen()));
+    }
+    const ConfigDiff::Changes layoutChanges = clockChanges | ConfigDiff::panel(m_panelConfig, panel);
+
+    m_kdeConfig = clock;
+    m_panelConfig = panel;
+    m_screenPanels = screenPanels;
+
+    if (clockChanges & ConfigDiff::FormatChange) {
+        m_formatter = ClockFormatter(m_kdeConfig);
+        m_tickScheduler->setGranularity(m_formatter.showsSeconds() ? TickScheduler::Second
+                                                                   : TickScheduler::Minute);
+    }
+    if (layoutChanges & ConfigDiff::SizeChange) {
+        m_layoutDevicePixelRatio = QGuiApplication::primaryScreen()->devicePixelRatio();
+        m_layout = ClockLayout::compute(m_kdeConfig, m_panelConfig, m_layoutDevicePixelRatio);
+    }
+
+    int anchored = 0, resized = 0, reformatted = 0;
+    for (ClockOutput* output : m_outputs) {
+        const KDEPanelConfig outputPanel = panelFor(output->screen());
+        const ConfigDiff::Changes changes =
+            clockChanges | ConfigDiff::panel(oldPanels.value(output), outputPanel);
+
+        if (changes & ConfigDiff::AnchorChange) {
+            output->setup(m_kdeConfig, outputPanel, layoutFor(output->screen(), outputPanel));
+            anchored++;
+        } else if (changes & ConfigDiff::SizeChange) {
+            output->resize(m_kdeConfig, outputPanel, layoutFor(output->screen(), outputPanel));
+            resized++;
+        } else if (changes & ConfigDiff::FormatChange) {
+            output->setClockConfig(m_kdeConfig);
+            reformatted++;
+        }
+    }
+
+    if (anchored + resized + reformatted == 0) {
+        return;
+    }
+
+    qDebug() << "Config changed - re-anchored:" << anchored << "resized:" << resized
+             << "reformatted:" << reformatted << "- thickness:" << m_panelConfig.thickness
+             << "location:" << m_panelConfig.location;
+    updateTime();
+}
+
+KDEPanelConfig ClockController::panelConfig(const QString& screen) const
+{
+    return screen.isEmpty() ? m_panelConfig : m_screenPanels.value(screen, m_panelConfig);
+}
+
+bool ClockController::pushClockConfig(const KDEClockConfig& clock)
+{
+    if (!m_configLoaded) {
+        return false;
+    }
+    if (clock == m_kdeConfig) {
+        return true;
+    }
+
+    qDebug() << "Clock config pushed over D-Bus";
+    applyChanges(clock, m_panelConfig, m_screenPanels);
+    return true;
+}
+
+bool ClockController::pushPanelConfig(const QString& screen, const KDEPanelConfig& panel)
+{
+    if (!m_configLoaded) {
+        return false;
+    }
+    if (!screen.isEmpty()) {
+        // Per-screen panels are only used with --all-screens, and only for
+        // outputs that exist
+        if (!m_allScreens) {
+            return false;
+        }
+        bool known = false;
+        for (const ClockOutput* output : m_outputs) {
+            if (output->screen() && output->screen()->name() == screen) {
+                known = true;
+                break;
+            }
+        }
+        if (!known) {
+            return false;
+        }
+    }
+    if (panel == panelConfig(screen)) {
+        return true;
+    }
+
+    qDebug() << "Panel config pushed over D-Bus for" << (screen.isEmpty() ? "clock panel" : screen)
+             << "- thickness:" << panel.thickness << "location:" << panel.location;
+
+    if (screen.isEmpty()) {
+        applyChanges(m_kdeConfig, panel, m_screenPanels);
+    } else {
+        QHash<QString, KDEPanelConfig> screenPanels = m_screenPanels;
+        screenPanels.insert(screen, panel);
+        applyChanges(m_kdeConfig, m_panelConfig, screenPanels);
+    }
+    return true;
+}
+
+bool ClockController::setRepositionInterval(int ms)
+{
+    if (!m_configLoaded) {
+        return false;
+    }
+
+    m_repositionIntervalMs = ms;
+    for (ClockOutput* output : m_outputs) {
+        output->setRepositionInterval(ms);
+    }
+    return true;
+}
+
+bool ClockController::setColor(const QColor& color)
+{
+    if (!m_configLoaded) {
+        return false;
+    }
+
+    m_color = color;
+    for (ClockOutput* output : m_outputs) {
+        output->setColor(color);
+    }
+    return true;
+}
+
+void ClockController::saveStartupCache(const PlasmaConfigSnapshot& snapshot)
+{
+    // Only cache what is actually on screen
+    if (snapshot.clockConfig() != m_kdeConfig || snapshot.panelConfig() != m_panelConfig ||
+        snapshot.screenPanels() != m_screenPanels) {
+        return;
+    }
+
+    StartupCache::Entry entry;
+    entry.appletsrc = snapshot.appletsrcStamp();
+    entry.plasmashellrc = snapshot.plasmashellrcStamp();
+    entry.fontFamily = StartupCache::fontFamily();
+    entry.devicePixelRatio = QGuiApplication::primaryScreen()->devicePixelRatio();
+    entry.fingerprint = snapshot.fingerprint();
+    entry.clockConfig = m_kdeConfig;
+    entry.panelConfig = m_panelConfig;
+    entry.screenPanels = m_screenPanels;
+    entry.layout = m_layout;
+    StartupCache::save(entry);
+}
+
+void ClockController::saveState()
+{
+    // The last lit interval too, the map file is written through
+    for (ClockOutput* output : m_outputs) {
+        output->accountExposure();
+        output->saveSequence();
+    }
+}
+
+void ClockController::setupTrayIcon()
+{
+    // Nothing to rasterize until the icon is actually shown
+    if (!m_showTrayIcon || m_trayIcon) {
+        return;
+    }
+
+    m_trayIcon = new QSystemTrayIcon(this);
+    m_trayIcon->setIcon(TrayIconCache::instance()->icon());
+    m_trayIcon->setToolTip("Plasma Clock OLED");
+    connect(TrayIconCache::instance(), &TrayIconCache::iconChanged, m_trayIcon, [this]() {
+        m_trayIcon->setIcon(TrayIconCache::instance()->icon());
+    });
+
+    // Plasma shows the tray menu itself over dbusmenu, which needs it
+    // attached before the icon is shown. The tray is set up after the
+    // first frame, so building the menu here keeps it off that path too.
+    ensureContextMenu();
+    m_trayIcon->setContextMenu(m_contextMenu);
+    m_trayIcon->show();
+}
+
+void ClockController::ensureContextMenu()
+{
+    if (m_contextMenu) {
+        return;
+    }
+
+    // Create context menu (shared between clock widget and tray)
+    // Use nullptr parent to avoid inheriting transparent background
+    m_contextMenu = new QMenu();
+    m_contextMenu->setAttribute(Qt::WA_TranslucentBackground, false);
+    m_toggleTrayAction = m_contextMenu->addAction(
+        m_showTrayIcon ? "Hide Tray Icon" : "Show Tray Icon",
+        this, &ClockController::toggleTrayIcon);
+    m_contextMenu->addSeparator();
+    m_contextMenu->addAction("Quit", qApp, &QApplication::quit);
+}
+
+void ClockController::showContextMenu()
+{
+    if (!m_trayAvailable) {
+        return;
+    }
+
+    ensureContextMenu();
+
+    // Use cursor position - more reliable on Wayland
+    m_contextMenu->popup(QCursor::pos());
+}
+
+void ClockController::toggleTrayIcon()
+{
+    m_showTrayIcon = !m_showTrayIcon;
+
+    if (m_showTrayIcon) {
+        if (m_trayIcon) {
+            m_trayIcon->show();
+        } else {
+            setupTrayIcon();
+        }
+        m_toggleTrayAction->setText("Hide Tray Icon");
+    } else {
+        if (m_trayIcon) {
+            m_trayIcon->hide();
+        }
+        m_toggleTrayAction->setText("Show Tray Icon");
+    }
+
+    saveSettings();
+}
+
+void ClockController::loadSettings()
+{
+    m_showTrayIcon = m_settings.value("showTrayIcon", true).toBool();
+    m_watchConfigFiles = m_settings.value("watchConfigFiles", true).toBool();
+
+    const QString placement = m_settings.value("placement").toString();
+    if (placement == "wear-leveling") {
+        m_placement = ClockOutput::WearLevelingPlacement;
+    } else if (placement == "low-discrepancy") {
+        m_placement = ClockOutput::LowDiscrepancyPlacement;
+    } else {
+        m_placement = ClockOutput::RandomPlacement;
+    }
+}
+
+void ClockController::saveSettings()
+{
+    m_settings.setValue("showTrayIcon", m_showTrayIcon);
+    m_settings.sync();
+}
+
+void ClockController::onScreenAdded(QScreen* screen)
+{
+    if (!isRealScreen(screen)) {
+        qDebug() << "Ignoring placeholder screen";
+        return;
+    }
+
+    qDebug() << "Real screen added:" << screen->name();
+
+    m_rebindTimer.start();
+
+    // Give the output a moment to settle before binding a surface to it
+    QTimer::singleShot(200, this, &ClockController::syncOutputs);
+}
+
+void ClockController::onScreenRemoved(QScreen* screen)
+{
+    // A single clock follows the primary screen and is rebound on the next
+    // screenAdded; per-screen clocks go away with their screen
+    if (!m_allScreens) {
+        return;
+    }
+
+    if (ClockOutput* output = outputFor(screen)) {
+        qDebug() << "Removing clock from" << screen->name();
+        m_outputs.removeOne(output);
+        delete output;
+    }
+}
+
+void ClockController::syncOutputs()
+{
+    if (!m_configLoaded) {
+        // Nothing shown yet, the first build picks up the new screens
+        return;
+    }
+
+    if (m_allScreens) {
+        // New screens only cost a new surface, config and formatter are shared
+        for (QScreen* screen : targetScreens()) {
+            if (!outputFor(screen)) {
+                addOutput(screen);
+            }
+        }
+    } else if (!m_outputs.isEmpty()) {
+        // The old surface can't be converted back to layer shell after
+        // screen changes, bind a fresh one
+        m_outputs.first()->rebind(QGuiApplication::primaryScreen());
+        updateTime();
+    }
+
+    if (m_trayIcon) {
+        m_trayIcon->setIcon(TrayIconCache::instance()->icon());
+    }
+}
+
+void ClockController::setupDBus()
+{
+    // Uses DBUS_SESSION_BUS_ADDRESS, so a private dbus-daemon works as well
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    if (!bus.isConnected()) {
+        qDebug() << "No session bus, metrics, config and control interfaces not exported";
+        return;
+    }
+
+    new MetricsAdaptor(this, this);
+    new ConfigAdaptor(this);
+    new ControlAdaptor(this);
+    if (!bus.registerObject("/org/ustek/PlasmaClockOled", this, QDBusConnection::ExportAdaptors) ||
+        !bus.registerService("org.ustek.PlasmaClockOled")) {
+        qDebug() << "Failed to register on the session bus:" << bus.lastError().message();
+    }
+}
+
+quint64 ClockController::tickCount() const
+{
+    return m_tickScheduler ? m_tickScheduler->tickCount() : 0;
+}
+
+QList<quint64> ClockController::jitterHistogram() const
+{
+    if (!m_tickScheduler) {
+        return QList<quint64>(TickScheduler::JitterBucketCount, 0);
+    }
+    return m_tickScheduler->jitterHistogram();
+}
+
+quint64 ClockController::wakeupCount() const
+{
+    // Recorded by every source: ticks, repositions, config file and clock
+    // change events, config loads; screen and tray events are rare enough
+    // to ignore
+    return Wakeups::total();
+}
+
+double ClockController::wakeupsPerMinute() const
+{
+    return Wakeups::perMinute();
+}
+
+quint64 ClockController::repaintCount() const
+{
+    quint64 count = 0;
+    for (const ClockOutput* output : m_outputs) {
+        count += output->paintCount();
+    }
+    return count;
+}
+
+qint64 ClockController::paintTimeNs() const
+{
+    qint64 time = 0;
+    for (const ClockOutput* output : m_outputs) {
+        time += output->paintTimeNs();
+    }
+    return time;
+}
+
+quint64 ClockController::pixelsPainted() const
+{
+    quint64 pixels = 0;
+    for (const ClockOutput* output : m_outputs) {
+        pixels += output->pixelsPainted();
+    }
+    return pixels;
+}
+
+quint64 ClockController::configLoadCount() const
+{
+    return m_configLoader->loadCount();
+}
+
+qint64 ClockController::lastConfigLoadTimeNs() const
+{
+    return m_configLoader->lastLoadTimeNs();
+}
+
+qint64 ClockController::totalConfigLoadTimeNs() const
+{
+    return m_configLoader->totalLoadTimeNs();
+}
+
+quint64 ClockController::configEventsSkipped() const
+{
+    return m_configWatcher ? m_configWatcher->skippedCount() : 0;
+}
+
+quint64 ClockController::configSnapshotsSkipped() const
+{
+    return m_configLoader->skippedCount();
+}
+
+quint64 ClockController::repositionCount() const
+{
+    quint64 count = 0;
+    for (const ClockOutput* output : m_outputs) {
+        count += output->repositionCount();
+    }
+    return count;
+}
+
+QPoint ClockController::position() const
+{
+    // Of the primary screen's clock
+    if (ClockOutput* output = outputFor(QGuiApplication::primaryScreen())) {
+        return output->position();
+    }
+    return m_outputs.isEmpty() ? QPoint() : m_outputs.first()->position();
+}
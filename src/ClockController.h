@@ -0,0 +1,142 @@
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <QScreen>
+#include <QSystemTrayIcon>
+#include <QMenu>
+#include <QSettings>
+#include <QElapsedTimer>
+#include <QColor>
+#include <QHash>
+#include <QList>
+#include <QPoint>
+#include "KDEClockConfig.h"
+#include "ClockLayout.h"
+#include "ClockFormatter.h"
+#include "MetricsSource.h"
+
+class ClockOutput;
+class ClockSurface;
+class ConfigLoader;
+class ConfigWatcher;
+class TickScheduler;
+class PlasmaConfigSnapshot;
+
+// Clock logic independent of how it is drawn: config loading, ticking,
+// formatting and the tray. The time is formatted once per tick and fanned
+// out to one ClockOutput per screen (or only the primary one), each drawing
+// into a ClockSurface: a QWidget (default) or a lighter QRasterWindow.
+// On screen hotplug only surfaces are added or rebound; config, layout,
+// glyphs and tray are kept.
+
+class ClockController : public QObject, public MetricsSource
+{
+    Q_OBJECT
+
+public:
+    enum Backend {
+        WidgetBackend,
+        RasterBackend
+    };
+
+    ClockController(Backend backend, bool allScreens, QObject *parent = nullptr);
+    ~ClockController() override;
+
+    // Live counters, exported on the session bus by MetricsAdaptor
+    quint64 tickCount() const override;
+    QList<quint64> jitterHistogram() const override;
+    quint64 wakeupCount() const override;
+    double wakeupsPerMinute() const override;
+    quint64 repaintCount() const override;
+    quint64 repaintsSkipped() const override { return m_repaintsSkipped; }
+    qint64 paintTimeNs() const override;
+    quint64 pixelsPainted() const override;
+    quint64 configLoadCount() const override;
+    qint64 lastConfigLoadTimeNs() const override;
+    qint64 totalConfigLoadTimeNs() const override;
+    quint64 configEventsSkipped() const override;
+    quint64 configSnapshotsSkipped() const override;
+    quint64 repositionCount() const override;
+    QPoint position() const override;
+    qint64 uptimeMs() const override { return m_startupTimer.elapsed(); }
+
+    // Settings pushed over D-Bus by ConfigAdaptor, applied to the running
+    // outputs without reading config files. The next change to the clock
+    // or panel sections of Plasma's config (if it is watched) replaces
+    // pushed clock and panel settings; edits that leave those sections'
+    // fingerprint unchanged do not. All return false until the clock has
+    // been built.
+    // pushPanelConfig also returns false for a named screen without a
+    // clock, or any named screen without --all-screens.
+    const KDEClockConfig& clockConfig() const { return m_kdeConfig; }
+    bool pushClockConfig(const KDEClockConfig& clock);
+    // An empty screen is the clock panel, used wherever a screen has none
+    KDEPanelConfig panelConfig(const QString& screen) const;
+    bool pushPanelConfig(const QString& screen, const KDEPanelConfig& panel);
+    bool setRepositionInterval(int ms);
+    bool setColor(const QColor& color);
+
+private slots:
+    void updateTime();
+    void toggleTrayIcon();
+    void onScreenAdded(QScreen* screen);
+    void onScreenRemoved(QScreen* screen);
+    void syncOutputs();
+    void saveState();
+
+private:
+    ClockSurface* createSurface();
+    void onFirstFrame();
+    static bool isRealScreen(QScreen* screen);
+    QList<QScreen*> targetScreens() const;
+    ClockOutput* outputFor(QScreen* screen) const;
+    KDEPanelConfig panelFor(QScreen* screen) const;
+    ClockLayout layoutFor(QScreen* screen, const KDEPanelConfig& panel) const;
+    void setupOutput(ClockOutput* output);
+    void addOutput(QScreen* screen);
+    void setupTimers();
+    void setupConfigWatcher();
+    void setupDBus();
+    void setupTrayIcon();
+    void ensureContextMenu();
+    void showContextMenu();
+    void reloadConfig();
+    void applyConfig(const PlasmaConfigSnapshot& snapshot);
+    void applyChanges(const KDEClockConfig& clock, const KDEPanelConfig& panel,
+                      const QHash<QString, KDEPanelConfig>& screenPanels);
+    void saveStartupCache(const PlasmaConfigSnapshot& snapshot);
+    void buildClock();
+    void loadSettings();
+    void saveSettings();
+
+    Backend m_backend;
+    bool m_allScreens;
+    QList<ClockOutput*> m_outputs;
+    int m_placement;  // ClockOutput::Placement
+    int m_repositionIntervalMs;  // 0: the placement's default
+    QColor m_color;
+    TickScheduler* m_tickScheduler;
+    ConfigWatcher* m_configWatcher;
+    ConfigLoader* m_configLoader;
+    QSystemTrayIcon* m_trayIcon;
+    QMenu* m_contextMenu;
+    QAction* m_toggleTrayAction;
+    QSettings m_settings;
+
+    bool m_showTrayIcon;
+    bool m_watchConfigFiles;
+    bool m_trayAvailable;
+    bool m_configLoaded;
+    bool m_firstFrameShown;
+
+    KDEClockConfig m_kdeConfig;
+    KDEPanelConfig m_panelConfig;
+    QHash<QString, KDEPanelConfig> m_screenPanels;
+    ClockLayout m_layout;
+    qreal m_layoutDevicePixelRatio;
+    ClockFormatter m_formatter;
+    quint64 m_repaintsSkipped;
+    QElapsedTimer m_startupTimer;
+    QElapsedTimer m_rebindTimer;
+};
@@ -0,0 +1,91 @@
+#include "ClockFormatter.h"
+
+ClockFormatter::ClockFormatter()
+    : ClockFormatter(KDEClockConfig())
+{
+}
+
+ClockFormatter::ClockFormatter(const KDEClockConfig& config, const QLocale& locale)
+    : m_locale(locale)
+    , m_localeTime(false)
+    , m_showsSeconds(false)
+    , m_dateStyle(ShortDate)
+    , m_customDateFormat(config.customDateFormat)
+{
+    // Handle 24h format setting
+    // 0 = 12h, 1 = region default, 2 = 24h
+    // Handle seconds display
+    // 0 = never, 1 = tooltip only, 2 = always
+    const bool seconds = config.showSeconds == 2;
+    if (config.use24hFormat == 0) {
+        m_timeFormat = seconds ? "h:mm:ss AP" : "h:mm AP";
+    } else if (config.use24hFormat == 2) {
+        m_timeFormat = seconds ? "HH:mm:ss" : "HH:mm";
+    } else {
+        // Region default
+        m_localeTime = true;
+        m_timeFormat = m_locale.timeFormat(QLocale::ShortFormat);
+        if (seconds && !m_timeFormat.contains("ss")) {
+            m_timeFormat.replace("mm", "mm:ss");
+        }
+    }
+
+    // Decides whether ticks come every second. A locale's own format can
+    // show seconds regardless of the setting, and an 's' in quoted text
+    // (e.g. "h:mm 'hrs'") is not a seconds field.
+    m_showsSeconds = hasSecondsToken(m_timeFormat);
+
+    if (config.dateFormat == "longDate") {
+        m_dateStyle = LongDate;
+    } else if (config.dateFormat == "isoDate") {
+        m_dateStyle = IsoDate;
+    } else if (config.dateFormat == "custom") {
+        m_dateStyle = CustomDate;
+    }
+}
+
+bool ClockFormatter::hasSecondsToken(const QString& format)
+{
+    // QTime format syntax: text between single quotes is literal, and ''
+    // is a literal quote either inside or outside of it
+    bool quoted = false;
+    for (const QChar c : format) {
+        if (c == '\'') {
+            quoted = !quoted;
+        } else if (!quoted && c == 's') {
+            return true;
+        }
+    }
+    return false;
+}
+
+QString ClockFormatter::formatTime(const QTime& time) const
+{
+    return m_localeTime ? m_locale.toString(time, m_timeFormat) : time.toString(m_timeFormat);
+}
+
+QString ClockFormatter::formatDate(const QDate& date)
+{
+    if (date == m_lastDate) {
+        return m_lastDateText;
+    }
+
+    switch (m_dateStyle) {
+        case LongDate:
+            m_lastDateText = m_locale.toString(date, QLocale::LongFormat);
+            break;
+        case IsoDate:
+            m_lastDateText = date.toString(Qt::ISODate);
+            break;
+        case CustomDate:
+            m_lastDateText = m_locale.toString(date, m_customDateFormat);
+            break;
+        case ShortDate:
+        default:
+            m_lastDateText = m_locale.toString(date, QLocale::ShortFormat);
+            break;
+    }
+    m_lastDate = date;
+
+    return m_lastDateText;
+}
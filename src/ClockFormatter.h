@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QDate>
+#include <QLocale>
+#include <QString>
+#include <QTime>
+#include "KDEClockConfig.h"
+
+// Time and date formatting resolved once per config change. The format
+// strings are derived from the KDE clock settings and the system locale up
+// front, and the date text is only recomputed when the day changes.
+
+class ClockFormatter
+{
+public:
+    ClockFormatter();
+    explicit ClockFormatter(const KDEClockConfig& config, const QLocale& locale = QLocale::system());
+
+    QString formatTime(const QTime& time) const;
+    QString formatDate(const QDate& date);
+
+    bool showsSeconds() const { return m_showsSeconds; }
+
+private:
+    enum DateStyle {
+        ShortDate,
+        LongDate,
+        IsoDate,
+        CustomDate
+    };
+
+    static bool hasSecondsToken(const QString& format);
+
+    QLocale m_locale;
+    QString m_timeFormat;
+    bool m_localeTime;
+    bool m_showsSeconds;
+    DateStyle m_dateStyle;
+    QString m_customDateFormat;
+
+    QDate m_lastDate;
+    QString m_lastDateText;
+};
@@ -0,0 +1,195 @@
+#include "ClockLayout.h"
+#include "Config.h"
+
+#include <QFont>
+#include <QFontMetrics>
+#include <QFontMetricsF>
+#include <QHash>
+#include <QStringList>
+
+QString ClockLayout::timeSample(const KDEClockConfig& clock)
+{
+    QString sample = (clock.showSeconds == 2) ? "00:00:00" : "00:00";
+    if (clock.use24hFormat == 0) {
+        sample = (clock.showSeconds == 2) ? "00:00:00 AM" : "00:00 AM";
+    }
+    return sample;
+}
+
+QString ClockLayout::dateSample(const KDEClockConfig& clock)
+{
+    // Determine date sample based on format
+    if (clock.dateFormat == "longDate") {
+        return "Wednesday, December 30";  // Approximate longest
+    } else if (clock.dateFormat == "isoDate") {
+        return "0000-00-00";
+    }
+    return "00.00.0000";  // Short date
+}
+
+// Font metrics scale almost linearly with pixel size, so sizes are solved
+// from metrics measured once at this size and then corrected for hinting
+static constexpr int ReferencePixelSize = 100;
+static constexpr int MinFontSize = 8;
+
+static quint64 s_fontProbes = 0;
+
+// Results are shared across rebuilds, keyed by family, thickness,
+// orientation, samples and DPR
+static QHash<QString, ClockLayout>& layoutCache()
+{
+    static QHash<QString, ClockLayout> cache;
+    return cache;
+}
+
+void ClockLayout::clearCache()
+{
+    layoutCache().clear();
+}
+
+static QFontMetrics metricsFor(int pixelSize)
+{
+    s_fontProbes++;
+    QFont font(Config::FontFamily);
+    font.setPixelSize(pixelSize);
+    return QFontMetrics(font);
+}
+
+quint64 ClockLayout::fontProbes()
+{
+    return s_fontProbes;
+}
+
+// Largest size from MinFontSize up to guess that fits, or MinFontSize if
+// none does. The solved guess is usually right or a size or two too big,
+// so it is probed first and then sizes below it in steps of 1, 2, 4, ...
+// until one fits; the gap left is bisected. Even a guess far off, e.g.
+// for a fallback font with other proportions, costs about 2 * log2(guess)
+// probes instead of leaving an overflowing size.
+template<typename Fits>
+static int largestFitting(int guess, Fits fits)
+{
+    if (guess <= MinFontSize) {
+        return MinFontSize;
+    }
+    if (fits(guess)) {
+        return guess;
+    }
+
+    int high = guess;  // does not fit
+    int low = guess - 1;
+    for (int step = 2; low > MinFontSize && !fits(low); step *= 2) {
+        high = low;
+        low = qMax(MinFontSize, high - step);
+    }
+    // low fits, or is the minimum; nothing from high up does
+    while (high - low > 1) {
+        const int mid = low + (high - low) / 2;
+        if (fits(mid)) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// Largest size up to maxSize whose sample fits availableWidth
+static int fitWidth(const QString& sample, qreal referenceAdvance, int maxSize,
+                    int availableWidth, int* capHeight)
+{
+    int size = maxSize;
+    if (referenceAdvance > 0) {
+        size = qMin(maxSize, static_cast<int>(availableWidth * ReferencePixelSize / referenceAdvance));
+    }
+
+    size = largestFitting(size, [&sample, availableWidth](int candidate) {
+        return metricsFor(candidate).horizontalAdvance(sample) <= availableWidth;
+    });
+
+    *capHeight = metricsFor(size).capHeight();
+    return size;
+}
+
+ClockLayout ClockLayout::compute(const KDEClockConfig& clock, const KDEPanelConfig& panel,
+                                 qreal devicePixelRatio)
+{
+    const int panelThickness = panel.thickness;
+    const bool vertical = (panel.location == 5 || panel.location == 6);
+
+    // Determine the sample text for width calculation
+    const QString timeText = timeSample(clock);
+    const QString dateText = clock.showDate ? dateSample(clock) : QString();
+
+    QHash<QString, ClockLayout>& cache = layoutCache();
+    const QString key = QStringList{
+        QString::fromLatin1(Config::FontFamily), QString::number(panelThickness),
+        vertical ? "v" : "h", timeText, dateText, QString::number(devicePixelRatio)
+    }.join('|');
+
+    auto cached = cache.constFind(key);
+    if (cached != cache.cend()) {
+        return cached.value();
+    }
+
+    QFont referenceFont(Config::FontFamily);
+    referenceFont.setPixelSize(ReferencePixelSize);
+    const QFontMetricsF reference(referenceFont);
+
+    ClockLayout layout;
+
+    if (vertical) {
+        // For vertical panels: each label fills width independently
+        const int availableWidth = panelThickness - 4;  // 2px padding each side
+
+        layout.timeFontSize = fitWidth(timeText, reference.horizontalAdvance(timeText),
+                                       panelThickness, availableWidth, &layout.timeCapHeight);
+        if (clock.showDate) {
+            layout.dateFontSize = fitWidth(dateText, reference.horizontalAdvance(dateText),
+                                           panelThickness, availableWidth, &layout.dateCapHeight);
+        }
+    } else {
+        // For horizontal panels: use KDE Digital Clock ratios
+        // time 0.56, date 0.8 * time, or time 0.71 alone
+        const double dateRatio = 0.8;
+        const qreal capRatio = reference.capHeight() / ReferencePixelSize;
+
+        // Solve capHeight(time) + 2 [+ 4 + capHeight(date) + 2] <= thickness
+        int timeFontSize;
+        if (clock.showDate) {
+            timeFontSize = static_cast<int>(panelThickness * 0.56);
+            if (capRatio > 0) {
+                timeFontSize = qMin(timeFontSize,
+                    static_cast<int>((panelThickness - 8) / (capRatio * (1.0 + dateRatio))));
+            }
+        } else {
+            timeFontSize = static_cast<int>(panelThickness * 0.71);
+            if (capRatio > 0) {
+                timeFontSize = qMin(timeFontSize,
+                                    static_cast<int>((panelThickness - 2) / capRatio));
+            }
+        }
+
+        // Then corrected for hinting until both lines fit
+        auto dateSizeFor = [dateRatio](int timeSize) {
+            return qMax(static_cast<int>(timeSize * dateRatio), MinFontSize);
+        };
+        timeFontSize = largestFitting(timeFontSize, [&](int candidate) {
+            int totalHeight = metricsFor(candidate).capHeight() + 2;
+            if (clock.showDate) {
+                totalHeight += 4 + metricsFor(dateSizeFor(candidate)).capHeight() + 2;
+            }
+            return totalHeight <= panelThickness;
+        });
+
+        layout.timeFontSize = timeFontSize;
+        layout.timeCapHeight = metricsFor(timeFontSize).capHeight();
+        if (clock.showDate) {
+            layout.dateFontSize = dateSizeFor(timeFontSize);
+            layout.dateCapHeight = metricsFor(layout.dateFontSize).capHeight();
+        }
+    }
+
+    cache.insert(key, layout);
+    return layout;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <QString>
+#include "KDEClockConfig.h"
+
+// Font sizes and cap heights for the time and date lines, derived from
+// the panel thickness and orientation and the clock format. Sizes are
+// solved directly from reference metrics and cached per
+// (family, thickness, orientation, samples, DPR) for the whole process.
+
+struct ClockLayout {
+    int timeFontSize = 0;
+    int dateFontSize = 0;
+    int timeCapHeight = 0;
+    int dateCapHeight = 0;
+
+    static ClockLayout compute(const KDEClockConfig& clock, const KDEPanelConfig& panel,
+                               qreal devicePixelRatio);
+    static QString timeSample(const KDEClockConfig& clock);
+    static QString dateSample(const KDEClockConfig& clock);
+
+    // Drop all cached results, so the next compute() measures fonts again
+    static void clearCache();
+
+    // Font sizes measured by compute() since startup, for the bench
+    static quint64 fontProbes();
+
+    bool isValid() const { return timeFontSize > 0; }
+};
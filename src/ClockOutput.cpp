@@ -0,0 +1,463 @@
+#include "ClockOutput.h"
+#include "ClockSource.h"
+#include "ClockSurface.h"
+#include "Config.h"
+#include "Placement.h"
+#include "Wakeups.h"
+
+#include <QColor>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QSettings>
+#include <QWindow>
+
+#include <LayerShellQt/Window>
+
+ClockOutput::ClockOutput(const SurfaceFactory& createSurface, QScreen* screen, QObject *parent)
+    : QObject(parent)
+    , m_createSurface(createSurface)
+    , m_surface(nullptr)
+    , m_repositionTimer(new ClockTimer(this))
+    , m_placement(RandomPlacement)
+    , m_repositionIntervalMs(0)
+    , m_headless(false)
+    , m_color(Config::FontColor)
+    , m_minPos(0)
+    , m_maxPos(0)
+    , m_repositionCount(0)
+    , m_retiredPaintCount(0)
+    , m_retiredPaintTimeNs(0)
+    , m_retiredPixelsPainted(0)
+    , m_rng(std::random_device{}())
+    , m_sequence(-1.0)
+    , m_litSinceMs(-1)
+    , m_litRemainderMs(0)
+{
+    m_surface = m_createSurface();
+    m_surface->setRenderer(&m_renderer);
+    bindScreen(screen);
+
+    connect(m_repositionTimer, &ClockTimer::timeout, this, [this]() {
+        Wakeups::record();
+        reposition();
+    });
+}
+
+ClockOutput::~ClockOutput()
+{
+    accountExposure();
+    saveSequence();
+    delete m_surface;
+}
+
+void ClockOutput::bindScreen(QScreen* screen)
+{
+    if (m_screen) {
+        disconnect(m_screen, nullptr, this, nullptr);
+    }
+    m_screen = screen;
+    m_surface->setSurfaceScreen(screen);
+
+    connect(screen, &QScreen::geometryChanged,
+            this, &ClockOutput::calculateBounds);
+    connect(screen, &QScreen::geometryChanged,
+            this, &ClockOutput::reposition);
+}
+
+void ClockOutput::setup(const KDEClockConfig& clock, const KDEPanelConfig& panel,
+                        const ClockLayout& layout)
+{
+    applyLayout(clock, panel, layout);
+    configureLayerShell();
+}
+
+void ClockOutput::resize(const KDEClockConfig& clock, const KDEPanelConfig& panel,
+                         const ClockLayout& layout)
+{
+    // Same edge: the anchors stay, only the margins need to fit the new bounds
+    applyLayout(clock, panel, layout);
+    reposition();
+}
+
+void ClockOutput::applyLayout(const KDEClockConfig& clock, const KDEPanelConfig& panel,
+                              const ClockLayout& layout)
+{
+    // Exposure so far belongs to the old size and position
+    accountExposure();
+    if (panel.location != m_panelConfig.location) {
+        // Each edge has its own map, calculateBounds() opens the new one
+        m_exposure.close();
+    }
+
+    m_clockConfig = clock;
+    m_panelConfig = panel;
+    m_layout = layout;
+
+    // The screen may be gone between a hot-unplug and the next rebind
+    const qreal dpr = m_screen ? m_screen->devicePixelRatio()
+                               : m_surface->surfaceDevicePixelRatio();
+    m_renderer.setup(m_layout, m_clockConfig, dpr, m_color);
+    m_renderer.setTime(m_time);
+    if (m_clockConfig.showDate) {
+        m_renderer.setDate(m_date);
+    }
+    m_surface->resizeSurface(m_renderer.size());
+    m_surface->damage(QRect(QPoint(0, 0), m_renderer.size()));
+
+    qDebug() << "Widget size:" << m_surface->surfaceSize();
+
+    calculateBounds();
+}
+
+void ClockOutput::show()
+{
+    if (!m_headless) {
+        m_surface->showSurface();
+    }
+    m_repositionTimer->start(repositionInterval());
+}
+
+void ClockOutput::setPlacement(Placement placement)
+{
+    m_placement = placement;
+    if (m_placement == LowDiscrepancyPlacement) {
+        loadSequence();
+    }
+    if (m_repositionTimer->isActive()) {
+        m_repositionTimer->start(repositionInterval());
+    }
+}
+
+void ClockOutput::setRepositionInterval(int ms)
+{
+    m_repositionIntervalMs = ms;
+    if (m_repositionTimer->isActive()) {
+        m_repositionTimer->start(repositionInterval());
+    }
+}
+
+int ClockOutput::repositionInterval() const
+{
+    if (m_repositionIntervalMs > 0) {
+        return m_repositionIntervalMs;
+    }
+
+    // Targeted moves even out wear with fewer of them
+    return m_placement == WearLevelingPlacement ? Config::WearLevelingIntervalMs
+                                                : Config::RepositionIntervalMs;
+}
+
+void ClockOutput::rebind(QScreen* screen)
+{
+    qDebug() << "Rebinding layer shell surface to" << screen->name();
+
+    const qreal oldDpr = m_renderer.devicePixelRatio();
+
+    m_retiredPaintCount += m_surface->paintCount();
+    m_retiredPaintTimeNs += m_surface->paintTimeNs();
+    m_retiredPixelsPainted += m_surface->pixelsPainted();
+    delete m_surface;
+    m_surface = m_createSurface();
+    m_surface->setRenderer(&m_renderer);
+    bindScreen(screen);
+
+    // Glyphs are only re-rendered if the new output has a different scale
+    if (!qFuzzyCompare(oldDpr, screen->devicePixelRatio())) {
+        setup(m_clockConfig, m_panelConfig, m_layout);
+    } else {
+        m_surface->resizeSurface(m_renderer.size());
+        m_surface->damage(QRect(QPoint(0, 0), m_renderer.size()));
+        calculateBounds();
+        configureLayerShell();
+    }
+
+    show();
+}
+
+void ClockOutput::setColor(const QColor& color)
+{
+    if (color == m_color) {
+        return;
+    }
+
+    m_color = color;
+    if (!m_layout.isValid()) {
+        // Not set up yet, setup() picks up the color
+        return;
+    }
+
+    // Same fonts, so the same size: only the glyphs are rasterized again
+    m_renderer.setup(m_layout, m_clockConfig, m_renderer.devicePixelRatio(), m_color);
+    m_renderer.setTime(m_time);
+    if (m_clockConfig.showDate) {
+        m_renderer.setDate(m_date);
+    }
+    m_surface->damage(QRect(QPoint(0, 0), m_renderer.size()));
+}
+
+quint64 ClockOutput::paintCount() const
+{
+    return m_retiredPaintCount + m_surface->paintCount();
+}
+
+qint64 ClockOutput::paintTimeNs() const
+{
+    return m_retiredPaintTimeNs + m_surface->paintTimeNs();
+}
+
+quint64 ClockOutput::pixelsPainted() const
+{
+    return m_retiredPixelsPainted + m_surface->pixelsPainted();
+}
+
+bool ClockOutput::setText(const QString& time, const QString& date)
+{
+    m_time = time;
+    m_date = date;
+
+    // Repaint only the glyph cells whose text changed
+    QRegion damage = m_renderer.setTime(time);
+    if (m_clockConfig.showDate) {
+        damage += m_renderer.setDate(date);
+    }
+
+    if (damage.isEmpty()) {
+        return false;
+    }
+    m_surface->damage(damage);
+    return true;
+}
+
+void ClockOutput::configureLayerShell()
+{
+    if (m_headless) {
+        reposition();
+        return;
+    }
+
+    // Create window handle
+    QWindow* window = m_surface->nativeWindow();
+
+    if (auto* layerWindow = LayerShellQt::Window::get(window)) {
+        layerWindow->setLayer(LayerShellQt::Window::LayerBottom);
+        layerWindow->setExclusiveZone(0);
+        layerWindow->setKeyboardInteractivity(LayerShellQt::Window::KeyboardInteractivityNone);
+
+        // Set anchors based on panel location
+        LayerShellQt::Window::Anchors anchors;
+        switch (m_panelConfig.location) {
+            case 3: // Top
+                anchors = LayerShellQt::Window::Anchors(
+                    LayerShellQt::Window::AnchorTop | LayerShellQt::Window::AnchorLeft);
+                break;
+            case 4: // Bottom
+            default:
+                anchors = LayerShellQt::Window::Anchors(
+                    LayerShellQt::Window::AnchorBottom | LayerShellQt::Window::AnchorLeft);
+                break;
+            case 5: // Left
+                anchors = LayerShellQt::Window::Anchors(
+                    LayerShellQt::Window::AnchorLeft | LayerShellQt::Window::AnchorTop);
+                break;
+            case 6: // Right
+                anchors = LayerShellQt::Window::Anchors(
+                    LayerShellQt::Window::AnchorRight | LayerShellQt::Window::AnchorTop);
+                break;
+        }
+        layerWindow->setAnchors(anchors);
+
+        reposition();
+    }
+}
+
+bool ClockOutput::isVerticalPanel() const
+{
+    return m_panelConfig.location == 5 || m_panelConfig.location == 6;
+}
+
+int ClockOutput::crossMargin() const
+{
+    // Centered across the panel, as a layer shell margin from its screen edge
+    const QSize size = m_surface->surfaceSize();
+    const int crossSize = isVerticalPanel() ? size.width() : size.height();
+    return qMax(0, (m_panelConfig.thickness - crossSize) / 2);
+}
+
+int ClockOutput::litCrossOffset() const
+{
+    // The same position from the top/left of the panel band, which is how
+    // the exposure map counts it. Bottom and right panels take their margin
+    // from the far edge, so an odd remainder falls on the other side.
+    if (m_panelConfig.location == 3 || m_panelConfig.location == 5) { // Top or left panel
+        return crossMargin();
+    }
+    const QSize size = m_surface->surfaceSize();
+    const int crossSize = isVerticalPanel() ? size.width() : size.height();
+    return m_panelConfig.thickness - crossMargin() - crossSize;
+}
+
+void ClockOutput::calculateBounds()
+{
+    if (!m_screen) {
+        return;
+    }
+
+    // Get panel rectangle
+    const QRect panelRect = m_panelConfig.getPanelRect(m_screen->geometry());
+    if (panelRect.size() != m_panelRect.size() || !m_exposure.isOpen()) {
+        accountExposure();
+        m_exposure.open(QString("%1-%2").arg(m_screen->name()).arg(m_panelConfig.location),
+                        panelRect.size());
+    }
+    m_panelRect = panelRect;
+
+    // Calculate bounds within the panel
+    // For horizontal panels (top/bottom), move along X axis
+    // For vertical panels (left/right), move along Y axis
+    if (isVerticalPanel()) {
+        // Vertical panel - clock moves up/down within panel
+        m_minPos = Config::HorizontalPadding;
+        m_maxPos = m_panelRect.height() - m_surface->surfaceSize().height() - Config::HorizontalPadding;
+    } else {
+        // Horizontal panel - clock moves left/right within panel
+        m_minPos = Config::HorizontalPadding;
+        m_maxPos = m_panelRect.width() - m_surface->surfaceSize().width() - Config::HorizontalPadding;
+    }
+}
+
+void ClockOutput::accountExposure()
+{
+    if (m_litSinceMs < 0) {
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Whole seconds only, the rest carries over to the next position
+    const qint64 nowMs = ClockSource::instance()->monotonicMs();
+    const qint64 litMs = nowMs - m_litSinceMs + m_litRemainderMs;
+    m_litSinceMs = nowMs;
+    m_litRemainderMs = litMs % 1000;
+    m_exposure.add(m_renderer.alphaMask(), m_litOffset, static_cast<quint32>(litMs / 1000));
+
+    qDebug() << "Exposure of" << litMs / 1000 << "s at" << m_litOffset << "recorded in"
+             << timer.nsecsElapsed() / 1000 << "us";
+}
+
+void ClockOutput::reposition()
+{
+    LayerShellQt::Window* layerWindow = nullptr;
+    if (!m_headless) {
+        layerWindow = LayerShellQt::Window::get(m_surface->nativeWindow());
+        if (!layerWindow) {
+            return;
+        }
+    }
+
+    accountExposure();
+    m_repositionCount++;
+
+    int pos;
+    switch (m_placement) {
+        case WearLevelingPlacement:
+            pos = leastWornPosition();
+            break;
+        case LowDiscrepancyPlacement:
+            pos = sequencePosition();
+            break;
+        case RandomPlacement:
+        default:
+            pos = randomPosition();
+            break;
+    }
+
+    QMargins margins;
+    if (isVerticalPanel()) {
+        // Vertical panel - center horizontally, random vertical position
+        int hOffset = crossMargin();
+
+        qDebug() << "Panel thickness:" << m_panelConfig.thickness
+                 << "Widget width:" << m_surface->surfaceSize().width()
+                 << "hOffset:" << hOffset;
+
+        if (m_panelConfig.location == 5) { // Left panel
+            margins = QMargins(hOffset, pos, 0, 0);
+        } else { // Right panel
+            margins = QMargins(0, pos, hOffset, 0);
+        }
+        m_litOffset = QPoint(litCrossOffset(), pos);
+    } else {
+        // Horizontal panel - center vertically, random horizontal position
+        int vOffset = crossMargin();
+
+        qDebug() << "Panel thickness:" << m_panelConfig.thickness
+                 << "Widget height:" << m_surface->surfaceSize().height()
+                 << "vOffset:" << vOffset;
+
+        if (m_panelConfig.location == 3) { // Top panel
+            margins = QMargins(pos, vOffset, 0, 0);
+        } else { // Bottom panel (default)
+            margins = QMargins(pos, 0, 0, vOffset);
+        }
+        m_litOffset = QPoint(pos, litCrossOffset());
+    }
+
+    if (layerWindow) {
+        layerWindow->setMargins(margins);
+    }
+    m_litSinceMs = ClockSource::instance()->monotonicMs();
+
+    emit moved();
+}
+
+int ClockOutput::randomPosition()
+{
+    return Placement::random(m_rng, m_minPos, m_maxPos);
+}
+
+int ClockOutput::sequencePosition()
+{
+    loadSequence();
+    return Placement::sequence(m_sequence, m_minPos, m_maxPos);
+}
+
+void ClockOutput::loadSequence()
+{
+    // The phase is kept per screen so the sequence continues across
+    // restarts; in between it only lives here, moves don't touch settings
+    if (m_sequence >= 0.0) {
+        return;
+    }
+    m_sequenceKey = "sequence/" + (m_screen ? m_screen->name() : QString());
+    QSettings settings("Ustek", "plasma-clock-oled");
+    m_sequence = settings.value(m_sequenceKey, 0.5).toDouble();
+}
+
+void ClockOutput::saveSequence() const
+{
+    if (m_sequence < 0.0) {
+        return;
+    }
+    QSettings settings("Ustek", "plasma-clock-oled");
+    settings.setValue(m_sequenceKey, m_sequence);
+}
+
+int ClockOutput::leastWornPosition() const
+{
+    if (!m_exposure.isOpen()) {
+        return m_minPos;
+    }
+
+    // The clock stays centered across the panel, so only the band it
+    // covers matters
+    const QSize size = m_surface->surfaceSize();
+    const bool vertical = isVerticalPanel();
+    const int crossSize = vertical ? size.width() : size.height();
+    const int crossLength = vertical ? m_exposure.size().width() : m_exposure.size().height();
+    const int crossStart = qBound(0, litCrossOffset(), qMax(0, crossLength - crossSize));
+    const int crossEnd = qMin(crossLength, crossStart + crossSize);
+
+    return Placement::leastWorn(Placement::bandProfile(m_exposure, vertical, crossStart, crossEnd),
+                                vertical ? size.height() : size.width(), m_minPos, m_maxPos);
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <QColor>
+#include <QObject>
+#include <QPointer>
+#include <QRect>
+#include <QScreen>
+#include <functional>
+#include <random>
+#include "KDEClockConfig.h"
+#include "ClockLayout.h"
+#include "ClockRenderer.h"
+#include "ClockTimer.h"
+#include "ExposureMap.h"
+
+class ClockSurface;
+
+// One clock on one screen: its layer-shell surface, rendered glyphs,
+// bounds within the panel and its own reposition schedule. The time is
+// formatted once per tick by ClockController and handed to every output.
+// Time spent lit at each position is recorded in a persistent ExposureMap.
+
+class ClockOutput : public QObject
+{
+    Q_OBJECT
+
+public:
+    using SurfaceFactory = std::function<ClockSurface*()>;
+
+    enum Placement {
+        RandomPlacement,         // uniform random position
+        WearLevelingPlacement,   // least exposed position according to the ExposureMap
+        LowDiscrepancyPlacement  // golden-ratio sequence, even coverage in few moves
+    };
+
+    ClockOutput(const SurfaceFactory& createSurface, QScreen* screen, QObject *parent = nullptr);
+    ~ClockOutput() override;
+
+    QScreen* screen() const { return m_screen; }
+    ClockSurface* surface() const { return m_surface; }
+
+    // Size, anchor and bound the surface for this clock and panel
+    void setup(const KDEClockConfig& clock, const KDEPanelConfig& panel,
+               const ClockLayout& layout);
+
+    // Cheaper updates for changes that ConfigDiff found to keep the anchor
+    // (resize) or the layout (setClockConfig)
+    void resize(const KDEClockConfig& clock, const KDEPanelConfig& panel,
+                const ClockLayout& layout);
+    void setClockConfig(const KDEClockConfig& clock) { m_clockConfig = clock; }
+    void show();
+
+    void setPlacement(Placement placement);
+    int repositionInterval() const;
+
+    // Overrides the placement's reposition interval; 0 restores it
+    void setRepositionInterval(int ms);
+
+    // Redraws the glyphs in the new color, size and position are kept
+    void setColor(const QColor& color);
+
+    // Headless: never create a native window or touch layer shell, for
+    // the simulation
+    void setHeadless(bool headless) { m_headless = headless; }
+    void setRandomSeed(quint32 seed) { m_rng.seed(seed); }
+
+    // Add the time lit at the current position to the exposure map
+    void accountExposure();
+
+    // Persist the low-discrepancy sequence phase, if it is in use
+    void saveSequence() const;
+
+    QPoint position() const { return m_litOffset; }
+    quint64 repositionCount() const { return m_repositionCount; }
+
+    // Paint stats of all surfaces this output had, including rebound ones
+    quint64 paintCount() const;
+    qint64 paintTimeNs() const;
+    quint64 pixelsPainted() const;
+    const ExposureMap& exposure() const { return m_exposure; }
+
+    // Replace only the native surface, keeping glyphs and bounds logic
+    void rebind(QScreen* screen);
+
+    // Returns false if the text did not change anything on screen
+    bool setText(const QString& time, const QString& date);
+
+signals:
+    // After each reposition, with position() already updated
+    void moved();
+
+public slots:
+    void reposition();
+
+private slots:
+    void calculateBounds();
+
+private:
+    void bindScreen(QScreen* screen);
+    void applyLayout(const KDEClockConfig& clock, const KDEPanelConfig& panel,
+                     const ClockLayout& layout);
+    void configureLayerShell();
+    int randomPosition();
+    int leastWornPosition() const;
+    int sequencePosition();
+    void loadSequence();
+    bool isVerticalPanel() const;
+    int crossMargin() const;
+    int litCrossOffset() const;
+
+    SurfaceFactory m_createSurface;
+    QPointer<QScreen> m_screen;
+    ClockSurface* m_surface;
+    ClockTimer* m_repositionTimer;
+    Placement m_placement;
+    int m_repositionIntervalMs;
+    bool m_headless;
+    QColor m_color;
+
+    KDEClockConfig m_clockConfig;
+    KDEPanelConfig m_panelConfig;
+    ClockLayout m_layout;
+    ClockRenderer m_renderer;
+    QString m_time;
+    QString m_date;
+
+    int m_minPos;
+    int m_maxPos;
+    QRect m_panelRect;
+    quint64 m_repositionCount;
+    quint64 m_retiredPaintCount;    // paint stats of surfaces replaced by rebind()
+    qint64 m_retiredPaintTimeNs;
+    quint64 m_retiredPixelsPainted;
+    std::mt19937 m_rng;
+    double m_sequence;          // phase in [0, 1) of the low-discrepancy sequence, -1 until loaded
+    QString m_sequenceKey;      // settings key the phase was loaded from
+
+    ExposureMap m_exposure;
+    qint64 m_litSinceMs;        // ClockSource time the clock was placed at m_litOffset
+    QPoint m_litOffset;         // top left of the clock within the panel
+    qint64 m_litRemainderMs;
+};
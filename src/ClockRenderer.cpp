@@ -0,0 +1,318 @@
+#include "ClockRenderer.h"
+#include "Config.h"
+
+#include <QFontMetrics>
+#include <QLocale>
+#include <QPainter>
+#include <utility>
+
+void ClockRenderer::setup(const ClockLayout& layout, const KDEClockConfig& clock,
+                          qreal devicePixelRatio, const QColor& color)
+{
+    m_color = color;
+    m_dpr = devicePixelRatio;
+    m_showDate = clock.showDate;
+
+    m_timeFont = QFont(Config::FontFamily);
+    m_timeFont.setPixelSize(layout.timeFontSize);
+    m_timeFont.setWeight(QFont::Normal);
+    QFontMetrics timeFm(m_timeFont);
+
+    // How much space is above capHeight (for accents we don't have on numbers)
+    // Keep 2px buffer to avoid clipping top of numbers
+    int timeTopPadding = timeFm.ascent() - layout.timeCapHeight - 2;
+    if (timeTopPadding < 0) timeTopPadding = 0;
+
+    // Place the time line so capHeight portion starts at y=0 (let top padding get clipped)
+    m_timeTop = -timeTopPadding;
+    m_timeAscent = timeFm.ascent();
+    m_timeHeight = timeFm.height();
+
+    m_digitWidth = 0;
+    for (char digit = '0'; digit <= '9'; digit++) {
+        m_digitWidth = qMax(m_digitWidth, timeFm.horizontalAdvance(QChar(digit)));
+    }
+
+    // Everything a time string can contain in the common formats, anything
+    // else (other scripts, locale separators) is added on first use
+    const QLocale locale = QLocale::system();
+    m_atlas = QPixmap();
+    m_atlasChars.clear();
+    m_cells.clear();
+    addGlyphs("0123456789:. APM" + locale.amText() + locale.pmText());
+
+    const QString timeSample = ClockLayout::timeSample(clock);
+    QString pmSample = timeSample;
+    pmSample.replace("AM", "PM");
+    int widgetWidth = qMax(textWidth(timeSample), textWidth(pmSample));
+
+    // Calculate total content height
+    // Add 2px buffer for time, and 2px buffer for date if shown
+    int totalHeight = layout.timeCapHeight + 2;
+
+    m_dateFont = QFont(Config::FontFamily);
+    m_dateFont.setPixelSize(layout.dateFontSize > 0 ? layout.dateFontSize : layout.timeFontSize);
+    m_dateFont.setWeight(QFont::Normal);
+
+    if (m_showDate) {
+        QFontMetrics dateFm(m_dateFont);
+
+        // Keep 2px buffer for the date line as well
+        int dateTopPadding = dateFm.ascent() - layout.dateCapHeight - 2;
+        if (dateTopPadding < 0) dateTopPadding = 0;
+
+        // Position: capHeight of time ends at timeCapHeight, add 4px gap
+        // Then offset date line up by its top padding so capHeight starts at the gap
+        m_dateTop = layout.timeCapHeight + 4 - dateTopPadding + 2;  // +2 to account for time buffer
+
+        widgetWidth = qMax(widgetWidth, dateFm.horizontalAdvance(ClockLayout::dateSample(clock)));
+        totalHeight += 4 + layout.dateCapHeight + 2;
+    }
+
+    // Widget height is exactly the calculated totalHeight (capHeight based)
+    m_size = QSize(widgetWidth, totalHeight);
+
+    m_timeText.clear();
+    m_timeX = 0;
+    m_timeLine = QPixmap();
+    m_timeLineRect = QRect();
+    m_dateText.clear();
+    m_datePixmap = QPixmap();
+    m_dateRect = QRect();
+}
+
+bool ClockRenderer::isCellText(const QString& text)
+{
+    // Latin and script-neutral characters (digits, separators, spaces) have
+    // the same shape on their own as in the line; everything else may be
+    // shaped, combined or kerned together
+    for (QChar c : text) {
+        if (c.isSurrogate() || c.isMark() ||
+            (c.script() != QChar::Script_Latin && c.script() != QChar::Script_Common)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ClockRenderer::addGlyphs(const QString& chars)
+{
+    QString newChars;
+    for (QChar c : chars) {
+        if (isCellText(QString(c)) && !m_atlasChars.contains(c) && !newChars.contains(c)) {
+            newChars.append(c);
+        }
+    }
+    if (newChars.isEmpty()) {
+        return;
+    }
+    m_atlasChars += newChars;
+
+    // Rebuild the whole atlas; this happens once per font/DPR in practice
+    QFontMetrics fm(m_timeFont);
+    int atlasWidth = 0;
+    m_cells.clear();
+    for (QChar c : std::as_const(m_atlasChars)) {
+        Cell cell;
+        cell.width = c.isDigit() ? m_digitWidth : fm.horizontalAdvance(c);
+
+        // Narrow digits are centered in the shared digit cell; the ink box
+        // reaches past the cell wherever the glyph overhangs its advance
+        const int pen = (cell.width - fm.horizontalAdvance(c)) / 2;
+        const QRect ink = fm.boundingRect(c);
+        cell.inkLeft = qMin(0, pen + ink.left());
+        cell.inkWidth = qMax(cell.width, pen + ink.right() + 1) - cell.inkLeft;
+
+        cell.x = atlasWidth;
+        m_cells.insert(c, cell);
+        atlasWidth += cell.inkWidth + 1;  // 1px gap so filtering never bleeds
+    }
+
+    m_atlas = QPixmap(QSize(atlasWidth, m_timeHeight) * m_dpr);
+    m_atlas.setDevicePixelRatio(m_dpr);
+    m_atlas.fill(Qt::transparent);
+
+    QPainter painter(&m_atlas);
+    painter.setFont(m_timeFont);
+    painter.setPen(m_color);
+    for (QChar c : std::as_const(m_atlasChars)) {
+        const Cell& cell = m_cells[c];
+        const int pen = (cell.width - fm.horizontalAdvance(c)) / 2;
+        painter.drawText(QPoint(cell.x - cell.inkLeft + pen, m_timeAscent), QString(c));
+    }
+}
+
+int ClockRenderer::textWidth(const QString& text) const
+{
+    if (!isCellText(text)) {
+        return QFontMetrics(m_timeFont).horizontalAdvance(text);
+    }
+
+    int width = 0;
+    for (QChar c : text) {
+        width += m_cells.value(c).width;
+    }
+    return width;
+}
+
+QRect ClockRenderer::cellRect(int x, const Cell& cell) const
+{
+    return QRect(x + cell.inkLeft, m_timeTop, cell.inkWidth, m_timeHeight);
+}
+
+QRegion ClockRenderer::cellsRegion() const
+{
+    QRegion region;
+    int x = m_timeX;
+    for (QChar c : m_timeText) {
+        const Cell cell = m_cells.value(c);
+        region += cellRect(x, cell);
+        x += cell.width;
+    }
+    return region;
+}
+
+QRegion ClockRenderer::setTime(const QString& text)
+{
+    if (text == m_timeText) {
+        return QRegion();
+    }
+
+    if (!isCellText(text)) {
+        return setTimeLine(text);
+    }
+
+    // Coming back from a whole line, e.g. a locale change
+    QRegion damage;
+    if (!m_timeLine.isNull()) {
+        damage += m_timeLineRect;
+        m_timeLine = QPixmap();
+        m_timeLineRect = QRect();
+        m_timeText.clear();
+    }
+
+    addGlyphs(text);
+
+    const int x = (m_size.width() - textWidth(text)) / 2;
+
+    // Damage every cell whose character or position changed, in the old
+    // and the new text
+    int oldX = m_timeX;
+    int newX = x;
+    const int count = qMax(text.size(), m_timeText.size());
+    for (int i = 0; i < count; i++) {
+        const bool hasOld = i < m_timeText.size();
+        const bool hasNew = i < text.size();
+        const Cell oldCell = hasOld ? m_cells.value(m_timeText[i]) : Cell();
+        const Cell newCell = hasNew ? m_cells.value(text[i]) : Cell();
+
+        if (!hasOld || !hasNew || m_timeText[i] != text[i] || oldX != newX) {
+            if (hasOld) damage += cellRect(oldX, oldCell);
+            if (hasNew) damage += cellRect(newX, newCell);
+        }
+        oldX += oldCell.width;
+        newX += newCell.width;
+    }
+
+    m_timeText = text;
+    m_timeX = x;
+
+    return damage & QRect(QPoint(0, 0), m_size);
+}
+
+QRegion ClockRenderer::setTimeLine(const QString& text)
+{
+    QRegion damage = m_timeLine.isNull() ? cellsRegion() : QRegion(m_timeLineRect);
+
+    // Shaped as a whole, ink box around the advance as for the cells
+    QFontMetrics fm(m_timeFont);
+    const int advance = fm.horizontalAdvance(text);
+    const QRect ink = fm.boundingRect(text);
+    const int inkLeft = qMin(0, ink.left());
+    const int inkWidth = qMax(advance, ink.right() + 1) - inkLeft;
+
+    m_timeLine = QPixmap(QSize(inkWidth, m_timeHeight) * m_dpr);
+    m_timeLine.setDevicePixelRatio(m_dpr);
+    m_timeLine.fill(Qt::transparent);
+
+    QPainter painter(&m_timeLine);
+    painter.setFont(m_timeFont);
+    painter.setPen(m_color);
+    painter.drawText(QPoint(-inkLeft, m_timeAscent), text);
+    painter.end();
+
+    m_timeX = (m_size.width() - advance) / 2;
+    m_timeLineRect = QRect(m_timeX + inkLeft, m_timeTop, inkWidth, m_timeHeight);
+    m_timeText = text;
+    damage += m_timeLineRect;
+
+    return damage & QRect(QPoint(0, 0), m_size);
+}
+
+QRegion ClockRenderer::setDate(const QString& text)
+{
+    if (!m_showDate || text == m_dateText) {
+        return QRegion();
+    }
+
+    QFontMetrics fm(m_dateFont);
+    const QSize textSize(fm.horizontalAdvance(text), fm.height());
+
+    m_datePixmap = QPixmap(textSize * m_dpr);
+    m_datePixmap.setDevicePixelRatio(m_dpr);
+    m_datePixmap.fill(Qt::transparent);
+
+    QPainter painter(&m_datePixmap);
+    painter.setFont(m_dateFont);
+    painter.setPen(m_color);
+    painter.drawText(QPoint(0, fm.ascent()), text);
+    painter.end();
+
+    QRegion damage(m_dateRect);
+    m_dateRect = QRect(QPoint((m_size.width() - textSize.width()) / 2, m_dateTop), textSize);
+    damage += m_dateRect;
+    m_dateText = text;
+
+    return damage & QRect(QPoint(0, 0), m_size);
+}
+
+void ClockRenderer::paint(QPainter& painter, const QRegion& region) const
+{
+    // Ink boxes of neighbouring cells can overlap; a cell redrawn for its
+    // neighbour's damage must not be drawn over itself outside it
+    painter.save();
+    painter.setClipRegion(region, Qt::IntersectClip);
+
+    if (!m_timeLine.isNull()) {
+        if (region.intersects(m_timeLineRect)) {
+            painter.drawPixmap(m_timeLineRect.topLeft(), m_timeLine);
+        }
+    } else {
+        int x = m_timeX;
+        for (QChar c : m_timeText) {
+            const Cell cell = m_cells.value(c);
+            const QRect rect = cellRect(x, cell);
+            if (region.intersects(rect)) {
+                painter.drawPixmap(QPointF(rect.x(), m_timeTop), m_atlas,
+                                   QRectF(cell.x * m_dpr, 0, cell.inkWidth * m_dpr, m_timeHeight * m_dpr));
+            }
+            x += cell.width;
+        }
+    }
+
+    if (!m_datePixmap.isNull() && region.intersects(m_dateRect)) {
+        painter.drawPixmap(m_dateRect.topLeft(), m_datePixmap);
+    }
+
+    painter.restore();
+}
+
+QImage ClockRenderer::alphaMask() const
+{
+    QImage mask(m_size, QImage::Format_Alpha8);
+    mask.fill(0);
+
+    QPainter painter(&mask);
+    paint(painter, QRect(QPoint(0, 0), m_size));
+    return mask;
+}
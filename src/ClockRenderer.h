@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QColor>
+#include <QFont>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QRect>
+#include <QRegion>
+#include <QString>
+#include "ClockLayout.h"
+#include "KDEClockConfig.h"
+
+class QPainter;
+
+// Paints the clock without QLabel/stylesheet machinery. Time glyphs
+// (digits, separators, AM/PM) are rasterized once per font/DPR into an
+// atlas and blitted per character cell; digits share one cell width so
+// the line does not jitter. Cells advance by the glyph's advance but blit
+// its whole ink box, so overhanging glyphs are not clipped. Text the atlas
+// can't lay out one character at a time (surrogate pairs, marks, non-Latin
+// scripts that need shaping) is drawn as a whole line instead. The date
+// changes once a day and is kept as a single pre-rendered pixmap.
+// setTime()/setDate() return only the damaged cells, so a seconds tick
+// repaints one or two digits.
+
+class ClockRenderer
+{
+public:
+    void setup(const ClockLayout& layout, const KDEClockConfig& clock,
+               qreal devicePixelRatio, const QColor& color);
+
+    QSize size() const { return m_size; }
+    qreal devicePixelRatio() const { return m_dpr; }
+
+    QRegion setTime(const QString& text);
+    QRegion setDate(const QString& text);
+
+    void paint(QPainter& painter, const QRegion& region) const;
+
+    // Coverage of the current content in logical pixels (Format_Alpha8)
+    QImage alphaMask() const;
+
+private:
+    struct Cell {
+        int x = 0;         // position of the ink box in the atlas, logical pixels
+        int width = 0;     // cell advance
+        int inkLeft = 0;   // ink box relative to the cell start, <= 0 if it overhangs
+        int inkWidth = 0;  // covers the advance and any overhang on either side
+    };
+
+    static bool isCellText(const QString& text);
+    void addGlyphs(const QString& chars);
+    int textWidth(const QString& text) const;
+    QRect cellRect(int x, const Cell& cell) const;
+    QRegion cellsRegion() const;
+    QRegion setTimeLine(const QString& text);
+
+    QFont m_timeFont;
+    QFont m_dateFont;
+    QColor m_color;
+    qreal m_dpr = 1.0;
+    QSize m_size;
+    bool m_showDate = false;
+
+    // Time line: glyph atlas, cells and current text
+    QPixmap m_atlas;
+    QString m_atlasChars;
+    QHash<QChar, Cell> m_cells;
+    int m_digitWidth = 0;
+    int m_timeTop = 0;
+    int m_timeHeight = 0;
+    int m_timeAscent = 0;
+    int m_timeX = 0;
+    QString m_timeText;
+
+    // Time text drawn as one line, when it can't be drawn per cell
+    QPixmap m_timeLine;
+    QRect m_timeLineRect;
+
+    // Date line
+    QPixmap m_datePixmap;
+    QRect m_dateRect;
+    int m_dateTop = 0;
+    QString m_dateText;
+};
@@ -0,0 +1,98 @@
+#include "ClockSource.h"
+#include "ClockTimer.h"
+
+namespace {
+
+class SystemClock : public ClockSource
+{
+public:
+    SystemClock() { m_monotonic.start(); }
+
+    QDateTime now() const override { return QDateTime::currentDateTime(); }
+    qint64 monotonicMs() const override { return m_monotonic.elapsed(); }
+
+private:
+    QElapsedTimer m_monotonic;
+};
+
+SystemClock s_systemClock;
+ClockSource* s_source = &s_systemClock;
+
+}
+
+bool ClockSource::schedule(ClockTimer* timer, int ms)
+{
+    Q_UNUSED(timer);
+    Q_UNUSED(ms);
+    return false;
+}
+
+void ClockSource::unschedule(ClockTimer* timer)
+{
+    Q_UNUSED(timer);
+}
+
+ClockSource* ClockSource::instance()
+{
+    return s_source;
+}
+
+void ClockSource::install(ClockSource* source)
+{
+    s_source = source ? source : &s_systemClock;
+}
+
+VirtualClock::VirtualClock(const QDateTime& start)
+    : m_start(start)
+    , m_elapsedMs(0)
+    , m_stepMs(0)
+    , m_order(0)
+{
+}
+
+QDateTime VirtualClock::now() const
+{
+    const QDateTime time = m_start.addMSecs(m_elapsedMs + m_stepMs);
+    return m_zone.isValid() ? time.toTimeZone(m_zone) : time;
+}
+
+bool VirtualClock::schedule(ClockTimer* timer, int ms)
+{
+    unschedule(timer);
+    m_pending.append({timer, m_elapsedMs + ms, m_order++});
+    return true;
+}
+
+void VirtualClock::unschedule(ClockTimer* timer)
+{
+    m_pending.removeIf([timer](const Pending& pending) { return pending.timer == timer; });
+}
+
+void VirtualClock::advance(qint64 ms)
+{
+    const qint64 target = m_elapsedMs + ms;
+
+    for (;;) {
+        int next = -1;
+        for (int i = 0; i < m_pending.size(); i++) {
+            const Pending& pending = m_pending[i];
+            if (pending.deadline > target) {
+                continue;
+            }
+            if (next < 0 || pending.deadline < m_pending[next].deadline ||
+                (pending.deadline == m_pending[next].deadline &&
+                 pending.order < m_pending[next].order)) {
+                next = i;
+            }
+        }
+        if (next < 0) {
+            break;
+        }
+
+        const Pending due = m_pending.takeAt(next);
+        m_elapsedMs = qMax(m_elapsedMs, due.deadline);
+        due.timer->expire();
+    }
+
+    m_elapsedMs = target;
+}
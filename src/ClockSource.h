@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QList>
+#include <QTimeZone>
+
+class ClockTimer;
+
+// Where the clock reads time from. The system clock by default; the
+// headless simulation and the tests install a VirtualClock that they
+// advance themselves, so days of ticks and moves run in seconds of wall
+// time. ClockTimers follow the installed source.
+
+class ClockSource
+{
+public:
+    virtual ~ClockSource() = default;
+
+    // Wall-clock time shown on the clock
+    virtual QDateTime now() const = 0;
+
+    // Monotonic milliseconds, for measuring how long something lasted
+    virtual qint64 monotonicMs() const = 0;
+
+    // Take over a ClockTimer expiring after ms of monotonic time; false if
+    // the timer should run on a real QTimer instead
+    virtual bool schedule(ClockTimer* timer, int ms);
+    virtual void unschedule(ClockTimer* timer);
+
+    static ClockSource* instance();
+
+    // Replace the time source; nullptr restores the system clock
+    static void install(ClockSource* source);
+};
+
+class VirtualClock : public ClockSource
+{
+public:
+    explicit VirtualClock(const QDateTime& start);
+
+    QDateTime now() const override;
+    qint64 monotonicMs() const override { return m_elapsedMs; }
+
+    bool schedule(ClockTimer* timer, int ms) override;
+    void unschedule(ClockTimer* timer) override;
+
+    // Let ms pass, firing every timer that expires on the way in order
+    void advance(qint64 ms);
+
+    // Step the wall clock (NTP, manual change) without time passing
+    void step(qint64 ms) { m_stepMs += ms; }
+
+    // Show the time in another zone from now on
+    void setTimeZone(const QTimeZone& zone) { m_zone = zone; }
+
+private:
+    struct Pending {
+        ClockTimer* timer;
+        qint64 deadline;
+        quint64 order;  // timers due at the same time fire as scheduled
+    };
+
+    QDateTime m_start;
+    QTimeZone m_zone;
+    qint64 m_elapsedMs;
+    qint64 m_stepMs;
+    QList<Pending> m_pending;
+    quint64 m_order;
+};
@@ -0,0 +1,28 @@
+#include "ClockSurface.h"
+#include "ClockRenderer.h"
+
+#include <QElapsedTimer>
+#include <QPainter>
+
+void ClockSurface::paintClock(QPainter& painter, const QRegion& region)
+{
+    if (!m_renderer) {
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    m_renderer->paint(painter, region);
+
+    const qreal dpr = surfaceDevicePixelRatio();
+    for (const QRect& rect : region) {
+        m_pixelsPainted += static_cast<quint64>(rect.width() * rect.height() * dpr * dpr);
+    }
+    m_paintCount++;
+    m_paintTimeNs += timer.nsecsElapsed();
+
+    if (m_paintCount == 1 && firstFramePainted) {
+        firstFramePainted();
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QRegion>
+#include <QSize>
+#include <functional>
+
+class QPainter;
+class QScreen;
+class QWindow;
+class ClockRenderer;
+
+// A window the clock is drawn into. ClockWidget (QWidget backend) and
+// ClockWindow (QRasterWindow backend) implement it, ClockController drives
+// either one through this interface.
+
+class ClockSurface
+{
+public:
+    virtual ~ClockSurface() = default;
+
+    // Native window for LayerShellQt, created on first use
+    virtual QWindow* nativeWindow() = 0;
+
+    // Output the surface is placed on, set before the native window exists
+    virtual void setSurfaceScreen(QScreen* screen) = 0;
+
+    virtual void resizeSurface(const QSize& size) = 0;
+    virtual QSize surfaceSize() const = 0;
+    virtual qreal surfaceDevicePixelRatio() const = 0;
+    virtual void showSurface() = 0;
+
+    // Schedule a repaint of only this region
+    virtual void damage(const QRegion& region) = 0;
+
+    void setRenderer(const ClockRenderer* renderer) { m_renderer = renderer; }
+
+    quint64 paintCount() const { return m_paintCount; }
+    qint64 paintTimeNs() const { return m_paintTimeNs; }
+    quint64 pixelsPainted() const { return m_pixelsPainted; }
+
+    std::function<void()> contextMenuRequested;
+
+    // Called once, right after the first frame has been painted
+    std::function<void()> firstFramePainted;
+
+    // Called when the application palette or the theme changed
+    std::function<void()> paletteChanged;
+
+protected:
+    // Paint the renderer's content in region and account for the cost
+    void paintClock(QPainter& painter, const QRegion& region);
+
+private:
+    const ClockRenderer* m_renderer = nullptr;
+    quint64 m_paintCount = 0;
+    qint64 m_paintTimeNs = 0;
+    quint64 m_pixelsPainted = 0;
+};
@@ -0,0 +1,55 @@
+#include "ClockTimer.h"
+#include "ClockSource.h"
+
+ClockTimer::ClockTimer(QObject *parent)
+    : QObject(parent)
+    , m_source(nullptr)
+    , m_interval(0)
+    , m_singleShot(false)
+    , m_active(false)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &ClockTimer::expire);
+}
+
+ClockTimer::~ClockTimer()
+{
+    stop();
+}
+
+void ClockTimer::start(int ms)
+{
+    stop();
+
+    m_interval = ms;
+    m_active = true;
+
+    ClockSource* source = ClockSource::instance();
+    if (source->schedule(this, ms)) {
+        m_source = source;
+    } else {
+        m_timer.start(ms);
+    }
+}
+
+void ClockTimer::stop()
+{
+    if (m_source) {
+        m_source->unschedule(this);
+        m_source = nullptr;
+    }
+    m_timer.stop();
+    m_active = false;
+}
+
+void ClockTimer::expire()
+{
+    // Re-armed before emitting, so the slot may stop or restart the timer
+    if (m_singleShot) {
+        m_source = nullptr;
+        m_active = false;
+    } else {
+        start(m_interval);
+    }
+    emit timeout();
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+
+class ClockSource;
+
+// A QTimer that runs on the installed ClockSource's monotonic time: a
+// precise QTimer with the system clock, and fired by VirtualClock::advance()
+// under a virtual clock, so schedulers can be tested and simulated in
+// virtual time without changes.
+
+class ClockTimer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ClockTimer(QObject *parent = nullptr);
+    ~ClockTimer() override;
+
+    void setSingleShot(bool singleShot) { m_singleShot = singleShot; }
+    bool isSingleShot() const { return m_singleShot; }
+    void setTimerType(Qt::TimerType type) { m_timer.setTimerType(type); }
+
+    void start(int ms);
+    void stop();
+
+    bool isActive() const { return m_active; }
+    int interval() const { return m_interval; }
+
+signals:
+    void timeout();
+
+private:
+    friend class VirtualClock;
+
+    // Called on expiry by the QTimer or the virtual clock
+    void expire();
+
+    QTimer m_timer;
+    ClockSource* m_source;  // virtual clock the timer is scheduled on, if any
+    int m_interval;
+    bool m_singleShot;
+    bool m_active;
+};
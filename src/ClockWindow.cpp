@@ -0,0 +1,53 @@
+#include "ClockWindow.h"
+
+#include <QMouseEvent>
+#include <QPaintEvent>
+#include <QPainter>
+#include <QSurfaceFormat>
+
+ClockWindow::ClockWindow()
+{
+    setFlags(Qt::FramelessWindowHint | Qt::WindowDoesNotAcceptFocus);
+
+    // Alpha channel for a transparent background
+    QSurfaceFormat surfaceFormat = format();
+    surfaceFormat.setAlphaBufferSize(8);
+    setFormat(surfaceFormat);
+}
+
+QWindow* ClockWindow::nativeWindow()
+{
+    create();
+    return this;
+}
+
+void ClockWindow::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::RightButton && contextMenuRequested) {
+        contextMenuRequested();
+    }
+}
+
+bool ClockWindow::event(QEvent* event)
+{
+    // QGuiApplication sends these to every top-level window
+    if ((event->type() == QEvent::ApplicationPaletteChange ||
+         event->type() == QEvent::ThemeChange) && paletteChanged) {
+        paletteChanged();
+    }
+    return QRasterWindow::event(event);
+}
+
+void ClockWindow::paintEvent(QPaintEvent* event)
+{
+    QPainter painter(this);
+
+    // Unlike translucent widgets, the backing store is not cleared for us
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    for (const QRect& rect : event->region()) {
+        painter.fillRect(rect, Qt::transparent);
+    }
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+
+    paintClock(painter, event->region());
+}
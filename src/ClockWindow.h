@@ -0,0 +1,28 @@
+#pragma once
+
+#include <QRasterWindow>
+#include "ClockSurface.h"
+
+// QRasterWindow backend: no QApplication, style or widget machinery, for
+// when the clock should cost as little memory and startup time as possible
+
+class ClockWindow : public QRasterWindow, public ClockSurface
+{
+    Q_OBJECT
+
+public:
+    ClockWindow();
+
+    QWindow* nativeWindow() override;
+    void setSurfaceScreen(QScreen* screen) override { setScreen(screen); }
+    void resizeSurface(const QSize& size) override { resize(size); }
+    QSize surfaceSize() const override { return size(); }
+    qreal surfaceDevicePixelRatio() const override { return devicePixelRatio(); }
+    void showSurface() override { show(); }
+    void damage(const QRegion& region) override { update(region); }
+
+protected:
+    bool event(QEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void paintEvent(QPaintEvent* event) override;
+};
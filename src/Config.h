@@ -2,7 +2,10 @@
 
 namespace Config {
     constexpr int RepositionIntervalMs = 30000;  // 30 seconds
-    constexpr int ClockUpdateIntervalMs = 1000;  // 1 second
+    constexpr int WearLevelingIntervalMs = 120000; // 2 minutes, moves target the least worn spot
+    constexpr int TickEarlyToleranceMs = 20;     // early wakeups re-armed to the boundary
+    constexpr int ConfigReloadDelayMs = 500;     // quiet time after last config change
+    constexpr int ConfigReloadMaxDelayMs = 2000; // max reload delay during change bursts
     constexpr int BottomOffset = 4;              // pixels from bottom edge
     constexpr int HorizontalPadding = 20;        // min pixels from edges
     constexpr const char* FontFamily = "Sans";
@@ -0,0 +1,81 @@
+#include "ConfigAdaptor.h"
+#include "ClockController.h"
+
+#include <QColor>
+
+ConfigAdaptor::ConfigAdaptor(ClockController* controller)
+    : QDBusAbstractAdaptor(controller)
+    , m_controller(controller)
+{
+}
+
+bool ConfigAdaptor::SetTimeFormat(int format)
+{
+    if (format < 0 || format > 2) {
+        return false;
+    }
+
+    KDEClockConfig clock = m_controller->clockConfig();
+    clock.use24hFormat = format;
+    return m_controller->pushClockConfig(clock);
+}
+
+bool ConfigAdaptor::SetShowSeconds(bool show)
+{
+    KDEClockConfig clock = m_controller->clockConfig();
+    clock.showSeconds = show ? 2 : 0;
+    return m_controller->pushClockConfig(clock);
+}
+
+bool ConfigAdaptor::SetShowDate(bool show)
+{
+    KDEClockConfig clock = m_controller->clockConfig();
+    clock.showDate = show;
+    return m_controller->pushClockConfig(clock);
+}
+
+bool ConfigAdaptor::SetDateFormat(const QString& format)
+{
+    if (format.isEmpty()) {
+        return false;
+    }
+
+    KDEClockConfig clock = m_controller->clockConfig();
+    if (format == "shortDate" || format == "longDate" || format == "isoDate") {
+        clock.dateFormat = format;
+    } else {
+        clock.dateFormat = "custom";
+        clock.customDateFormat = format;
+    }
+    return m_controller->pushClockConfig(clock);
+}
+
+bool ConfigAdaptor::SetPanelGeometry(const QString& screen, int location, int thickness)
+{
+    if (location < 3 || location > 6 || thickness <= 0) {
+        return false;
+    }
+
+    KDEPanelConfig panel = m_controller->panelConfig(screen);
+    panel.location = location;
+    panel.thickness = thickness;
+    return m_controller->pushPanelConfig(screen, panel);
+}
+
+bool ConfigAdaptor::SetRepositionInterval(int ms)
+{
+    // Moves more often than once a second only add wakeups
+    if (ms != 0 && ms < 1000) {
+        return false;
+    }
+    return m_controller->setRepositionInterval(ms);
+}
+
+bool ConfigAdaptor::SetColor(const QString& color)
+{
+    const QColor parsed(color);
+    if (!parsed.isValid()) {
+        return false;
+    }
+    return m_controller->setColor(parsed);
+}
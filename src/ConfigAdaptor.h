@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QDBusAbstractAdaptor>
+#include <QString>
+
+class ClockController;
+
+// Typed settings pushed to a running clock over the session bus, on the
+// same object as MetricsAdaptor. Each call changes only its own setting and
+// is applied in place, without touching config files, so managed machines
+// can drive the clock from scripts and turn the file watcher off
+// (watchConfigFiles=false). Methods return false for invalid values or
+// while the clock is still starting.
+
+class ConfigAdaptor : public QDBusAbstractAdaptor
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.ustek.PlasmaClockOled.Config")
+
+public:
+    explicit ConfigAdaptor(ClockController* controller);
+
+public slots:
+    // 0=12h, 1=region default, 2=24h, as use24hFormat in Plasma
+    bool SetTimeFormat(int format);
+    bool SetShowSeconds(bool show);
+    bool SetShowDate(bool show);
+    // shortDate, longDate, isoDate, or any other text as a QDate format
+    bool SetDateFormat(const QString& format);
+    // location: 3=top, 4=bottom, 5=left, 6=right; an empty screen is the
+    // clock panel, otherwise the panel on that output (with --all-screens)
+    bool SetPanelGeometry(const QString& screen, int location, int thickness);
+    // Milliseconds, 0 restores the placement's default
+    bool SetRepositionInterval(int ms);
+    // Any name QColor understands, e.g. #999999 or #80ffffff
+    bool SetColor(const QString& color);
+
+private:
+    ClockController* m_controller;
+};
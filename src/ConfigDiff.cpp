@@ -0,0 +1,31 @@
+#include "ConfigDiff.h"
+#include "ClockLayout.h"
+
+ConfigDiff::Changes ConfigDiff::clock(const KDEClockConfig& from, const KDEClockConfig& to)
+{
+    Changes changes;
+    if (from != to) {
+        changes |= FormatChange;
+    }
+
+    // Layout and clock size only depend on the sample texts
+    if (from.showDate != to.showDate ||
+        ClockLayout::timeSample(from) != ClockLayout::timeSample(to) ||
+        (to.showDate && ClockLayout::dateSample(from) != ClockLayout::dateSample(to))) {
+        changes |= SizeChange;
+    }
+    return changes;
+}
+
+ConfigDiff::Changes ConfigDiff::panel(const KDEPanelConfig& from, const KDEPanelConfig& to)
+{
+    // Moving to another edge can also change orientation and thickness;
+    // floating and the screen index don't affect the clock
+    if (from.location != to.location) {
+        return Changes(SizeChange | AnchorChange);
+    }
+    if (from.thickness != to.thickness) {
+        return SizeChange;
+    }
+    return NoChange;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <QFlags>
+#include "KDEClockConfig.h"
+
+// Classifies a config change by the cheapest update that applies it:
+// - FormatChange: the text changes but not its layout (24h/region default,
+//   seconds in the tooltip only, date formats with the same sample), so
+//   swapping the formatter is enough.
+// - SizeChange: font sizes or the clock size change (seconds or date shown,
+//   a longer date format, panel thickness). Glyphs, size and bounds are
+//   redone on the existing surface.
+// - AnchorChange: the panel moved to another edge and the layer surface
+//   has to be re-anchored.
+// A change can fall into several classes, e.g. showing seconds is both a
+// format and a size change.
+
+class ConfigDiff
+{
+public:
+    enum Change {
+        NoChange = 0x0,
+        FormatChange = 0x1,
+        SizeChange = 0x2,
+        AnchorChange = 0x4
+    };
+    Q_DECLARE_FLAGS(Changes, Change)
+
+    static Changes clock(const KDEClockConfig& from, const KDEClockConfig& to);
+    static Changes panel(const KDEPanelConfig& from, const KDEPanelConfig& to);
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(ConfigDiff::Changes)
@@ -0,0 +1,57 @@
+#include "ConfigLoader.h"
+#include "Wakeups.h"
+#include <QtConcurrent/QtConcurrentRun>
+#include <QDebug>
+
+ConfigLoader::ConfigLoader(QObject *parent)
+    : QObject(parent)
+    , m_load([]() { return PlasmaConfigSnapshot::load(); })
+    , m_pending(false)
+    , m_loadCount(0)
+    , m_skippedCount(0)
+    , m_lastLoadTimeNs(0)
+    , m_totalLoadTimeNs(0)
+{
+    connect(&m_watcher, &QFutureWatcher<PlasmaConfigSnapshot>::finished,
+            this, &ConfigLoader::onFinished);
+}
+
+void ConfigLoader::request()
+{
+    if (m_watcher.isRunning()) {
+        // The running load may have read the files before this change
+        m_pending = true;
+        return;
+    }
+
+    m_watcher.setFuture(QtConcurrent::run(m_load));
+}
+
+void ConfigLoader::onFinished()
+{
+    Wakeups::record();
+    const PlasmaConfigSnapshot snapshot = m_watcher.result();
+
+    // Stale loads cost the same, so they are counted too
+    m_loadCount++;
+    m_lastLoadTimeNs = snapshot.loadTimeNs();
+    m_totalLoadTimeNs += m_lastLoadTimeNs;
+
+    if (m_pending) {
+        // Result is already stale, start over instead of applying it
+        m_pending = false;
+        request();
+        return;
+    }
+
+    if (snapshot.fingerprint() == m_fingerprint) {
+        m_skippedCount++;
+        qDebug() << "Relevant config sections unchanged, skipping rebuild ("
+                 << m_skippedCount << "skipped so far)";
+        emit unchanged(snapshot);
+        return;
+    }
+
+    m_fingerprint = snapshot.fingerprint();
+    emit loaded(snapshot);
+}
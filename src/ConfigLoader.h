@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QObject>
+#include <QFutureWatcher>
+#include <functional>
+#include "PlasmaConfigSnapshot.h"
+
+// Loads PlasmaConfigSnapshot on a worker thread so slow config reads
+// (e.g. home on network storage) never block the GUI thread.
+// Requests made while a load is running are merged into one follow-up load.
+// Snapshots whose fingerprint matches the last applied one are dropped, so
+// writes to unrelated parts of appletsrc don't rebuild the clock.
+
+class ConfigLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    using LoadFunction = std::function<PlasmaConfigSnapshot()>;
+
+    explicit ConfigLoader(QObject *parent = nullptr);
+
+    void request();
+
+    // Runs on the worker instead of PlasmaConfigSnapshot::load, e.g. a
+    // deliberately slow read in tests
+    void setLoadFunction(const LoadFunction& load) { m_load = load; }
+
+    // Fingerprint of config applied from elsewhere (startup cache)
+    void setFingerprint(const QByteArray& fingerprint) { m_fingerprint = fingerprint; }
+
+    quint64 loadCount() const { return m_loadCount; }
+    quint64 skippedCount() const { return m_skippedCount; }
+    qint64 lastLoadTimeNs() const { return m_lastLoadTimeNs; }
+    qint64 totalLoadTimeNs() const { return m_totalLoadTimeNs; }
+
+signals:
+    void loaded(const PlasmaConfigSnapshot& snapshot);
+    // The files changed, but not the sections the clock uses
+    void unchanged(const PlasmaConfigSnapshot& snapshot);
+
+private slots:
+    void onFinished();
+
+private:
+    QFutureWatcher<PlasmaConfigSnapshot> m_watcher;
+    LoadFunction m_load;
+    QByteArray m_fingerprint;
+    bool m_pending;
+    quint64 m_loadCount;
+    quint64 m_skippedCount;
+    qint64 m_lastLoadTimeNs;
+    qint64 m_totalLoadTimeNs;
+};
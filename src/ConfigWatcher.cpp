@@ -0,0 +1,86 @@
+#include "ConfigWatcher.h"
+#include "Config.h"
+#include "Wakeups.h"
+#include <QFileInfo>
+#include <QDebug>
+
+ConfigWatcher::ConfigWatcher(const QStringList& files, QObject *parent)
+    : QObject(parent)
+    , m_pendingEvents(0)
+    , m_eventCount(0)
+    , m_reloadCount(0)
+    , m_skippedCount(0)
+{
+    QStringList directories;
+    for (const QString& file : files) {
+        m_stamps.insert(file, ConfigFileStamp::of(file));
+
+        QString dir = QFileInfo(file).absolutePath();
+        if (!directories.contains(dir)) {
+            directories.append(dir);
+        }
+    }
+    m_watcher.addPaths(directories);
+
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged,
+            this, &ConfigWatcher::onDirectoryChanged);
+
+    m_delayTimer.setSingleShot(true);
+    m_delayTimer.setInterval(Config::ConfigReloadDelayMs);
+    connect(&m_delayTimer, &QTimer::timeout, this, &ConfigWatcher::onDeadline);
+
+    m_maxDelayTimer.setSingleShot(true);
+    m_maxDelayTimer.setInterval(Config::ConfigReloadMaxDelayMs);
+    connect(&m_maxDelayTimer, &QTimer::timeout, this, &ConfigWatcher::onDeadline);
+
+    qDebug() << "Watching config files:" << files << "in" << directories;
+}
+
+void ConfigWatcher::onDirectoryChanged(const QString& path)
+{
+    Q_UNUSED(path);
+    Wakeups::record();
+
+    // The directory also changes for unrelated files and temp files of
+    // atomic saves; only count real changes to the tracked files
+    bool changedFile = false;
+    for (auto it = m_stamps.begin(); it != m_stamps.end(); ++it) {
+        ConfigFileStamp stamp = ConfigFileStamp::of(it.key());
+        if (stamp != it.value()) {
+            qDebug() << "Config file changed:" << it.key();
+            it.value() = stamp;
+            changedFile = true;
+        }
+    }
+    if (!changedFile) {
+        m_skippedCount++;
+        return;
+    }
+
+    m_eventCount++;
+    m_pendingEvents++;
+
+    // Trailing deadline restarts on every event, the cap does not
+    m_delayTimer.start();
+    if (!m_maxDelayTimer.isActive()) {
+        m_maxDelayTimer.start();
+    }
+}
+
+void ConfigWatcher::onDeadline()
+{
+    Wakeups::record();
+    m_delayTimer.stop();
+    m_maxDelayTimer.stop();
+
+    if (m_pendingEvents == 0) {
+        return;
+    }
+
+    m_reloadCount++;
+    qDebug() << "Config reload for" << m_pendingEvents << "change events,"
+             << coalescedCount() << "coalesced in total";
+    m_pendingEvents = 0;
+
+    emit changed();
+}
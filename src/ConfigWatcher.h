@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QObject>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QTimer>
+#include "PlasmaConfigSnapshot.h"
+
+// Watches Plasma's config files and merges bursts of changes into a single
+// reload. KConfig saves through an atomic rename, which replaces the inode a
+// file watch is attached to, so the containing directory is watched instead
+// and only changes to the tracked files' mtime/size count as events.
+// A reload fires once events stop for ConfigReloadDelayMs, and no later than
+// ConfigReloadMaxDelayMs after the first event of a burst.
+// Directory events that leave the tracked files' mtime/size untouched are
+// skipped without reading or hashing anything.
+
+class ConfigWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ConfigWatcher(const QStringList& files, QObject *parent = nullptr);
+
+    quint64 eventCount() const { return m_eventCount; }
+    quint64 reloadCount() const { return m_reloadCount; }
+    quint64 coalescedCount() const { return m_eventCount - m_reloadCount; }
+    quint64 skippedCount() const { return m_skippedCount; }
+
+signals:
+    void changed();
+
+private slots:
+    void onDirectoryChanged(const QString& path);
+    void onDeadline();
+
+private:
+    QFileSystemWatcher m_watcher;
+    QHash<QString, ConfigFileStamp> m_stamps;
+    QTimer m_delayTimer;
+    QTimer m_maxDelayTimer;
+    int m_pendingEvents;
+    quint64 m_eventCount;
+    quint64 m_reloadCount;
+    quint64 m_skippedCount;
+};
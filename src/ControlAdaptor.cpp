@@ -0,0 +1,15 @@
+#include "ControlAdaptor.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+
+ControlAdaptor::ControlAdaptor(QObject* object)
+    : QDBusAbstractAdaptor(object)
+{
+}
+
+void ControlAdaptor::Quit()
+{
+    qDebug() << "Quit requested over D-Bus";
+    QCoreApplication::quit();
+}
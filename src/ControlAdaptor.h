@@ -0,0 +1,20 @@
+#pragma once
+
+#include <QDBusAbstractAdaptor>
+
+// Controls of the running process on the session bus, on the same object
+// as MetricsAdaptor. The raster backend has neither tray icon nor context
+// menu, so this is how it is quit without a signal.
+
+class ControlAdaptor : public QDBusAbstractAdaptor
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.ustek.PlasmaClockOled")
+
+public:
+    explicit ControlAdaptor(QObject* object);
+
+public slots:
+    // Same as Quit in the context menu
+    Q_NOREPLY void Quit();
+};
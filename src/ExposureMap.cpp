@@ -0,0 +1,225 @@
+#include "ExposureMap.h"
+
+#include <QDir>
+#include <QStandardPaths>
+#include <QDebug>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static constexpr quint32 MapMagic = 0x4f455850;  // "OEXP"
+static constexpr quint32 MapVersion = 1;
+
+// A cell overflows after 2^32 / 255 seconds at full alpha (about 194
+// days); past this many accumulated seconds every cell is halved, which
+// keeps the relative wear the placement logic cares about
+static constexpr quint64 RescaleSeconds = (Q_UINT64_C(1) << 32) / 255 / 2;
+
+struct ExposureMap::Header {
+    quint32 magic;
+    quint32 version;
+    qint32 width;
+    qint32 height;
+    quint64 totalSeconds;
+};
+
+ExposureMap::~ExposureMap()
+{
+    close();
+}
+
+static QString s_directory;
+
+QString ExposureMap::directory()
+{
+    if (!s_directory.isEmpty()) {
+        return s_directory;
+    }
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/exposure";
+}
+
+void ExposureMap::setDirectory(const QString& directory)
+{
+    s_directory = directory;
+}
+
+ExposureMap::Header* ExposureMap::header() const
+{
+    return reinterpret_cast<Header*>(m_data);
+}
+
+bool ExposureMap::open(const QString& name, const QSize& size)
+{
+    close();
+
+    if (size.isEmpty()) {
+        return false;
+    }
+
+    QDir().mkpath(directory());
+    m_file.setFileName(directory() + "/" + name + ".map");
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        qDebug() << "Could not open exposure map:" << m_file.fileName();
+        return false;
+    }
+
+    const qint64 bytes = qint64(sizeof(Header)) + qint64(size.width()) * size.height() * sizeof(quint32);
+
+    bool reuse = false;
+    if (m_file.size() == bytes) {
+        Header existing;
+        if (m_file.read(reinterpret_cast<char*>(&existing), sizeof(existing)) == sizeof(existing)) {
+            reuse = existing.magic == MapMagic && existing.version == MapVersion &&
+                    existing.width == size.width() && existing.height == size.height();
+        }
+    }
+
+    if (!reuse) {
+        // New panel geometry, start with a clean slate
+        if (!m_file.resize(0) || !m_file.resize(bytes)) {
+            m_file.close();
+            return false;
+        }
+    }
+
+    m_data = m_file.map(0, bytes);
+    if (!m_data) {
+        m_file.close();
+        return false;
+    }
+
+    if (!reuse) {
+        Header* h = header();
+        h->magic = MapMagic;
+        h->version = MapVersion;
+        h->width = size.width();
+        h->height = size.height();
+        h->totalSeconds = 0;
+    }
+
+    m_cells = reinterpret_cast<quint32*>(m_data + sizeof(Header));
+    m_size = size;
+
+    qDebug() << (reuse ? "Reusing" : "Created") << "exposure map" << m_file.fileName()
+             << "with" << header()->totalSeconds << "s of history";
+    return true;
+}
+
+void ExposureMap::close()
+{
+    if (m_data) {
+        m_file.unmap(m_data);
+        m_data = nullptr;
+        m_cells = nullptr;
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_size = QSize();
+}
+
+quint64 ExposureMap::totalSeconds() const
+{
+    return m_data ? header()->totalSeconds : 0;
+}
+
+// dst[i] += src[i] * weight for one row of the mask
+static void addRow(quint32* dst, const uchar* src, int count, quint32 weight)
+{
+    int i = 0;
+
+#if defined(__SSE2__)
+    // 16 mask bytes per step: widen to 16 bit, multiply into 32 bit
+    // products (low and high halves) and add four vectors of cells
+    if (weight <= 0xffff) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i w = _mm_set1_epi16(static_cast<short>(weight));
+        for (; i + 16 <= count; i += 16) {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            const __m128i lo16 = _mm_unpacklo_epi8(bytes, zero);
+            const __m128i hi16 = _mm_unpackhi_epi8(bytes, zero);
+
+            const __m128i loLow = _mm_mullo_epi16(lo16, w);
+            const __m128i loHigh = _mm_mulhi_epu16(lo16, w);
+            const __m128i hiLow = _mm_mullo_epi16(hi16, w);
+            const __m128i hiHigh = _mm_mulhi_epu16(hi16, w);
+
+            __m128i* cells = reinterpret_cast<__m128i*>(dst + i);
+            _mm_storeu_si128(cells + 0, _mm_add_epi32(_mm_loadu_si128(cells + 0),
+                                                      _mm_unpacklo_epi16(loLow, loHigh)));
+            _mm_storeu_si128(cells + 1, _mm_add_epi32(_mm_loadu_si128(cells + 1),
+                                                      _mm_unpackhi_epi16(loLow, loHigh)));
+            _mm_storeu_si128(cells + 2, _mm_add_epi32(_mm_loadu_si128(cells + 2),
+                                                      _mm_unpacklo_epi16(hiLow, hiHigh)));
+            _mm_storeu_si128(cells + 3, _mm_add_epi32(_mm_loadu_si128(cells + 3),
+                                                      _mm_unpackhi_epi16(hiLow, hiHigh)));
+        }
+    }
+#endif
+
+    // Tail, and the whole row where SSE2 is unavailable (left to the
+    // compiler's auto-vectorizer)
+    for (; i < count; i++) {
+        dst[i] += src[i] * weight;
+    }
+}
+
+void ExposureMap::add(const QImage& mask, const QPoint& offset, quint32 seconds)
+{
+    if (!m_cells || seconds == 0 || mask.format() != QImage::Format_Alpha8) {
+        return;
+    }
+    seconds = static_cast<quint32>(qMin<quint64>(seconds, RescaleSeconds));
+
+    // Clip the mask against the map
+    const QRect target = QRect(offset, mask.size()) & QRect(QPoint(0, 0), m_size);
+    if (target.isEmpty()) {
+        return;
+    }
+    const int maskX = target.x() - offset.x();
+    const int maskY = target.y() - offset.y();
+
+    for (int y = 0; y < target.height(); y++) {
+        addRow(m_cells + (target.y() + y) * m_size.width() + target.x(),
+               mask.constScanLine(maskY + y) + maskX, target.width(), seconds);
+    }
+
+    header()->totalSeconds += seconds;
+    if (header()->totalSeconds > RescaleSeconds) {
+        rescale();
+    }
+}
+
+void ExposureMap::rescale()
+{
+    const qint64 count = qint64(m_size.width()) * m_size.height();
+    for (qint64 i = 0; i < count; i++) {
+        m_cells[i] >>= 1;
+    }
+    header()->totalSeconds >>= 1;
+}
+
+QImage ExposureMap::toImage() const
+{
+    QImage image(m_size, QImage::Format_Grayscale8);
+    if (!m_cells) {
+        return image;
+    }
+
+    quint32 maxValue = 1;
+    const qint64 count = qint64(m_size.width()) * m_size.height();
+    for (qint64 i = 0; i < count; i++) {
+        maxValue = qMax(maxValue, m_cells[i]);
+    }
+
+    for (int y = 0; y < m_size.height(); y++) {
+        uchar* line = image.scanLine(y);
+        const quint32* cells = row(y);
+        for (int x = 0; x < m_size.width(); x++) {
+            line[x] = static_cast<uchar>(quint64(cells[x]) * 255 / maxValue);
+        }
+    }
+    return image;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QFile>
+#include <QImage>
+#include <QPoint>
+#include <QSize>
+#include <QString>
+
+// Accumulated burn-in exposure of a panel area: per logical pixel, the sum
+// of the clock's alpha (0-255) times the seconds it was lit there. The map
+// lives in a memory-mapped file under $XDG_CACHE_HOME, so history survives
+// restarts and every add() is written through without explicit saves.
+
+class ExposureMap
+{
+public:
+    ExposureMap() = default;
+    ~ExposureMap();
+
+    ExposureMap(const ExposureMap&) = delete;
+    ExposureMap& operator=(const ExposureMap&) = delete;
+
+    // Map for the panel area identified by name: the output and the
+    // panel's location number, e.g. "DP-1-4" for a bottom panel. An
+    // existing file is reused if it has this size, otherwise started over.
+    bool open(const QString& name, const QSize& size);
+    void close();
+
+    bool isOpen() const { return m_cells != nullptr; }
+    QSize size() const { return m_size; }
+
+    // Add mask (Format_Alpha8) lit for seconds with its top left at offset
+    void add(const QImage& mask, const QPoint& offset, quint32 seconds);
+
+    quint32 at(int x, int y) const { return m_cells[y * m_size.width() + x]; }
+    const quint32* row(int y) const { return m_cells + y * m_size.width(); }
+
+    // Seconds accumulated over the map's lifetime, after any rescaling
+    quint64 totalSeconds() const;
+
+    // Heatmap scaled to the most exposed cell, black to white
+    QImage toImage() const;
+
+    static QString directory();
+    static void setDirectory(const QString& directory);
+
+private:
+    struct Header;
+
+    Header* header() const;
+    void rescale();
+
+    QFile m_file;
+    uchar* m_data = nullptr;
+    quint32* m_cells = nullptr;
+    QSize m_size;
+};
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <QByteArrayList>
 #include <QString>
 #include <QRect>
 
+class PlasmaConfigIndex;
+class PlasmaPanelMap;
+
 // KDE Digital Clock config keys and defaults from:
 // plasma-workspace/applets/digital-clock/package/contents/config/main.xml
 
@@ -12,8 +16,16 @@ struct KDEPanelConfig {
     bool floating = false;
     int screen = 0;
 
-    static KDEPanelConfig load();
+    static KDEPanelConfig fromIndex(const PlasmaConfigIndex& appletsrc,
+                                    const PlasmaConfigIndex& plasmashellrc);
+    static KDEPanelConfig fromPanels(const PlasmaPanelMap& panels);
     QRect getPanelRect(const QRect& screenGeom) const;
+
+    bool operator==(const KDEPanelConfig& other) const {
+        return location == other.location && thickness == other.thickness &&
+               floating == other.floating && screen == other.screen;
+    }
+    bool operator!=(const KDEPanelConfig& other) const { return !(*this == other); }
 };
 
 struct KDEClockConfig {
@@ -24,5 +36,15 @@ struct KDEClockConfig {
     int use24hFormat = 1; // 0=12h, 1=region default, 2=24h
     int dateDisplayFormat = 0;  // 0=adaptive, 1=beside, 2=below
 
-    static KDEClockConfig load();
+    static KDEClockConfig fromIndex(const PlasmaConfigIndex& appletsrc);
+    static KDEClockConfig fromApplet(const PlasmaConfigIndex& appletsrc,
+                                     const QByteArrayList& appletPath);
+
+    bool operator==(const KDEClockConfig& other) const {
+        return showDate == other.showDate && dateFormat == other.dateFormat &&
+               customDateFormat == other.customDateFormat &&
+               showSeconds == other.showSeconds && use24hFormat == other.use24hFormat &&
+               dateDisplayFormat == other.dateDisplayFormat;
+    }
+    bool operator!=(const KDEClockConfig& other) const { return !(*this == other); }
 };
@@ -0,0 +1,100 @@
+#include "MetricsAdaptor.h"
+#include "MetricsSource.h"
+#include "TickScheduler.h"
+
+MetricsAdaptor::MetricsAdaptor(QObject* object, const MetricsSource* source)
+    : QDBusAbstractAdaptor(object)
+    , m_source(source)
+{
+}
+
+qulonglong MetricsAdaptor::tickCount() const
+{
+    return m_source->tickCount();
+}
+
+QList<int> MetricsAdaptor::jitterBucketsMs() const
+{
+    return QList<int>(std::begin(TickScheduler::JitterBucketsMs),
+                      std::end(TickScheduler::JitterBucketsMs));
+}
+
+QList<qulonglong> MetricsAdaptor::jitterHistogram() const
+{
+    return m_source->jitterHistogram();
+}
+
+qulonglong MetricsAdaptor::wakeupCount() const
+{
+    return m_source->wakeupCount();
+}
+
+double MetricsAdaptor::wakeupsPerMinute() const
+{
+    return m_source->wakeupsPerMinute();
+}
+
+qulonglong MetricsAdaptor::repaintCount() const
+{
+    return m_source->repaintCount();
+}
+
+qulonglong MetricsAdaptor::repaintsSkipped() const
+{
+    return m_source->repaintsSkipped();
+}
+
+double MetricsAdaptor::paintTimeMs() const
+{
+    return m_source->paintTimeNs() / 1e6;
+}
+
+qulonglong MetricsAdaptor::pixelsPainted() const
+{
+    return m_source->pixelsPainted();
+}
+
+qulonglong MetricsAdaptor::configReloadCount() const
+{
+    return m_source->configLoadCount();
+}
+
+double MetricsAdaptor::configParseTimeMs() const
+{
+    return m_source->lastConfigLoadTimeNs() / 1e6;
+}
+
+double MetricsAdaptor::configParseTimeTotalMs() const
+{
+    return m_source->totalConfigLoadTimeNs() / 1e6;
+}
+
+qulonglong MetricsAdaptor::configEventsSkipped() const
+{
+    return m_source->configEventsSkipped();
+}
+
+qulonglong MetricsAdaptor::configSnapshotsSkipped() const
+{
+    return m_source->configSnapshotsSkipped();
+}
+
+qulonglong MetricsAdaptor::repositionCount() const
+{
+    return m_source->repositionCount();
+}
+
+QPoint MetricsAdaptor::position() const
+{
+    return m_source->position();
+}
+
+qlonglong MetricsAdaptor::residentSetKb() const
+{
+    return MetricsSource::residentSetKb();
+}
+
+qlonglong MetricsAdaptor::uptimeMs() const
+{
+    return m_source->uptimeMs();
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QDBusAbstractAdaptor>
+#include <QList>
+#include <QPoint>
+
+class MetricsSource;
+
+// Read-only counters of a running clock on the session bus, for monitoring
+// CPU and power use across machines. Exported by ClockController as
+// org.ustek.PlasmaClockOled at /org/ustek/PlasmaClockOled; values are
+// computed on each property read, so scraping costs nothing in between.
+// WakeupsPerMinute is the rate over the last few minutes, WakeupCount the
+// total since start.
+
+class MetricsAdaptor : public QDBusAbstractAdaptor
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.ustek.PlasmaClockOled.Metrics")
+    Q_PROPERTY(qulonglong TickCount READ tickCount)
+    Q_PROPERTY(QList<int> JitterBucketsMs READ jitterBucketsMs)
+    Q_PROPERTY(QList<qulonglong> JitterHistogram READ jitterHistogram)
+    Q_PROPERTY(qulonglong WakeupCount READ wakeupCount)
+    Q_PROPERTY(double WakeupsPerMinute READ wakeupsPerMinute)
+    Q_PROPERTY(qulonglong RepaintCount READ repaintCount)
+    Q_PROPERTY(qulonglong RepaintsSkipped READ repaintsSkipped)
+    Q_PROPERTY(double PaintTimeMs READ paintTimeMs)
+    Q_PROPERTY(qulonglong PixelsPainted READ pixelsPainted)
+    Q_PROPERTY(qulonglong ConfigReloadCount READ configReloadCount)
+    Q_PROPERTY(double ConfigParseTimeMs READ configParseTimeMs)
+    Q_PROPERTY(double ConfigParseTimeTotalMs READ configParseTimeTotalMs)
+    Q_PROPERTY(qulonglong ConfigEventsSkipped READ configEventsSkipped)
+    Q_PROPERTY(qulonglong ConfigSnapshotsSkipped READ configSnapshotsSkipped)
+    Q_PROPERTY(qulonglong RepositionCount READ repositionCount)
+    Q_PROPERTY(QPoint Position READ position)
+    Q_PROPERTY(qlonglong ResidentSetKb READ residentSetKb)
+    Q_PROPERTY(qlonglong UptimeMs READ uptimeMs)
+
+public:
+    // source must live as long as object, usually they are the same
+    MetricsAdaptor(QObject* object, const MetricsSource* source);
+
+    qulonglong tickCount() const;
+    QList<int> jitterBucketsMs() const;
+    QList<qulonglong> jitterHistogram() const;
+    qulonglong wakeupCount() const;
+    double wakeupsPerMinute() const;
+    qulonglong repaintCount() const;
+    qulonglong repaintsSkipped() const;
+    double paintTimeMs() const;
+    qulonglong pixelsPainted() const;
+    qulonglong configReloadCount() const;
+    double configParseTimeMs() const;
+    double configParseTimeTotalMs() const;
+    qulonglong configEventsSkipped() const;
+    qulonglong configSnapshotsSkipped() const;
+    qulonglong repositionCount() const;
+    QPoint position() const;
+    qlonglong residentSetKb() const;
+    qlonglong uptimeMs() const;
+
+private:
+    const MetricsSource* m_source;
+};
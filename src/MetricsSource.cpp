@@ -0,0 +1,19 @@
+#include "MetricsSource.h"
+#include <QByteArray>
+#include <QFile>
+
+#include <unistd.h>
+
+qint64 MetricsSource::residentSetKb()
+{
+    // Second field of /proc/self/statm is the resident set in pages
+    QFile statm("/proc/self/statm");
+    if (!statm.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2) {
+        return -1;
+    }
+    return fields[1].toLongLong() * (sysconf(_SC_PAGESIZE) / 1024);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QList>
+#include <QPoint>
+#include <QtGlobal>
+
+// Live counters MetricsAdaptor exports on the session bus. Implemented by
+// ClockController; the tests export a fake one on a private bus.
+
+class MetricsSource
+{
+public:
+    virtual ~MetricsSource() = default;
+
+    virtual quint64 tickCount() const = 0;
+    virtual QList<quint64> jitterHistogram() const = 0;
+    virtual quint64 wakeupCount() const = 0;
+    virtual double wakeupsPerMinute() const = 0;
+    virtual quint64 repaintCount() const = 0;
+    virtual quint64 repaintsSkipped() const = 0;
+    virtual qint64 paintTimeNs() const = 0;
+    virtual quint64 pixelsPainted() const = 0;
+    virtual quint64 configLoadCount() const = 0;
+    virtual qint64 lastConfigLoadTimeNs() const = 0;
+    virtual qint64 totalConfigLoadTimeNs() const = 0;
+    virtual quint64 configEventsSkipped() const = 0;
+    virtual quint64 configSnapshotsSkipped() const = 0;
+    virtual quint64 repositionCount() const = 0;
+    virtual QPoint position() const = 0;
+    virtual qint64 uptimeMs() const = 0;
+
+    // Of this process, in KiB; -1 if unknown
+    static qint64 residentSetKb();
+};
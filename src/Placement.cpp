@@ -0,0 +1,97 @@
+#include "Placement.h"
+#include "ExposureMap.h"
+
+#include <cmath>
+#include <deque>
+#include <limits>
+
+int Placement::random(std::mt19937& rng, int minPos, int maxPos)
+{
+    if (maxPos <= minPos) {
+        return minPos;
+    }
+    std::uniform_int_distribution<int> dist(minPos, maxPos);
+    return dist(rng);
+}
+
+int Placement::sequence(double& phase, int minPos, int maxPos)
+{
+    // Golden-ratio additive recurrence: every prefix of the sequence is
+    // spread almost evenly over [0, 1), unlike clustering uniform draws
+    static constexpr double GoldenRatioConjugate = 0.6180339887498949;
+
+    phase += GoldenRatioConjugate;
+    phase -= std::floor(phase);
+
+    if (maxPos <= minPos) {
+        return minPos;
+    }
+    return minPos + qRound(phase * (maxPos - minPos));
+}
+
+std::vector<quint32> Placement::bandProfile(const ExposureMap& exposure, bool vertical,
+                                            int crossStart, int crossEnd)
+{
+    const int length = vertical ? exposure.size().height() : exposure.size().width();
+
+    std::vector<quint32> profile(length, 0);
+    for (int c = crossStart; c < crossEnd; c++) {
+        if (vertical) {
+            for (int i = 0; i < length; i++) {
+                profile[i] = qMax(profile[i], exposure.at(c, i));
+            }
+        } else {
+            const quint32* row = exposure.row(c);
+            for (int i = 0; i < length; i++) {
+                profile[i] = qMax(profile[i], row[i]);
+            }
+        }
+    }
+    return profile;
+}
+
+int Placement::leastWorn(const std::vector<quint32>& profile, int footprint,
+                         int minPos, int maxPos)
+{
+    const int length = static_cast<int>(profile.size());
+    if (maxPos <= minPos || footprint <= 0 || maxPos + footprint > length) {
+        return minPos;
+    }
+
+    // Sliding window over the footprint: minimize the worst cell it would
+    // cover (monotonic deque), break ties by total exposure (prefix sums)
+    std::vector<quint64> prefix(length + 1, 0);
+    for (int i = 0; i < length; i++) {
+        prefix[i + 1] = prefix[i] + profile[i];
+    }
+
+    std::deque<int> window;
+    int best = minPos;
+    quint32 bestMax = std::numeric_limits<quint32>::max();
+    quint64 bestSum = std::numeric_limits<quint64>::max();
+
+    for (int i = 0; i < maxPos + footprint; i++) {
+        while (!window.empty() && profile[window.back()] <= profile[i]) {
+            window.pop_back();
+        }
+        window.push_back(i);
+
+        const int pos = i - footprint + 1;
+        if (pos < minPos) {
+            continue;
+        }
+        while (window.front() < pos) {
+            window.pop_front();
+        }
+
+        const quint32 worst = profile[window.front()];
+        const quint64 sum = prefix[pos + footprint] - prefix[pos];
+        if (worst < bestMax || (worst == bestMax && sum < bestSum)) {
+            best = pos;
+            bestMax = worst;
+            bestSum = sum;
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <QtGlobal>
+#include <random>
+#include <vector>
+
+class ExposureMap;
+
+// Choice of the clock's next offset along the panel, in [minPos, maxPos].
+// Free of surfaces and layer shell so it can be linked and measured on
+// its own; ClockOutput decides which policy to use and where to apply it.
+
+class Placement
+{
+public:
+    // Uniform random offset
+    static int random(std::mt19937& rng, int minPos, int maxPos);
+
+    // Advance a golden-ratio sequence phase in [0, 1) and map it to an offset
+    static int sequence(double& phase, int minPos, int maxPos);
+
+    // Worst cell at each position along the panel, over the cross-panel
+    // band [crossStart, crossEnd) the clock covers
+    static std::vector<quint32> bandProfile(const ExposureMap& exposure, bool vertical,
+                                            int crossStart, int crossEnd);
+
+    // Offset whose footprint covers the least worn worst cell, ties broken
+    // by total exposure; O(profile length)
+    static int leastWorn(const std::vector<quint32>& profile, int footprint,
+                         int minPos, int maxPos);
+};
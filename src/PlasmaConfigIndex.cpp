@@ -0,0 +1,225 @@
+#include "PlasmaConfigIndex.h"
+#include <QFile>
+#include <QCryptographicHash>
+#include <algorithm>
+#include <cstring>
+
+// KConfig joins nested group names with this character internally
+static constexpr char GroupSeparator = '\x1d';
+
+static inline bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+PlasmaConfigIndex PlasmaConfigIndex::fromFile(const QString& path)
+{
+    PlasmaConfigIndex index;
+
+    QFile file(path);
+    if (file.open(QIODevice::ReadOnly)) {
+        index.m_data = file.readAll();
+        file.close();
+        index.m_loaded = true;
+        index.parse();
+    }
+
+    return index;
+}
+
+PlasmaConfigIndex PlasmaConfigIndex::fromData(const QByteArray& data)
+{
+    PlasmaConfigIndex index;
+    index.m_data = data;
+    index.m_loaded = true;
+    index.parse();
+    return index;
+}
+
+QByteArray PlasmaConfigIndex::groupKey(const QByteArrayList& path)
+{
+    return path.join(GroupSeparator);
+}
+
+QByteArrayList PlasmaConfigIndex::groupPath(const QByteArray& key)
+{
+    return key.split(GroupSeparator);
+}
+
+void PlasmaConfigIndex::parse()
+{
+    const char* data = m_data.constData();
+    const int size = static_cast<int>(m_data.size());
+
+    // Entries are collected per group and merged into the index when the
+    // next header starts, so the group hash is touched once per group
+    QByteArray currentKey;
+    QHash<QByteArray, Span> currentEntries;
+
+    auto flush = [&]() {
+        if (currentEntries.isEmpty())
+            return;
+        Group& group = m_groups[currentKey];
+        if (group.entries.isEmpty()) {
+            group.entries = std::move(currentEntries);
+        } else {
+            // Repeated group header: later entries win, as in KConfig
+            for (auto it = currentEntries.cbegin(); it != currentEntries.cend(); ++it)
+                group.entries.insert(it.key(), it.value());
+        }
+        currentEntries = QHash<QByteArray, Span>();
+    };
+
+    int pos = 0;
+    while (pos < size) {
+        const char* newline = static_cast<const char*>(std::memchr(data + pos, '\n', size - pos));
+        const int lineEnd = newline ? static_cast<int>(newline - data) : size;
+
+        int start = pos;
+        int end = lineEnd;
+        pos = lineEnd + 1;
+
+        while (start < end && isBlank(data[start])) start++;
+        while (end > start && isBlank(data[end - 1])) end--;
+
+        if (start == end || data[start] == '#')
+            continue;
+
+        if (data[start] == '[') {
+            flush();
+
+            // Build the key incrementally so every parent is registered too
+            QByteArray key;
+            int p = start;
+            while (p < end && data[p] == '[') {
+                const char* close = static_cast<const char*>(
+                    std::memchr(data + p + 1, ']', end - p - 1));
+                if (!close)
+                    break;
+                const int closePos = static_cast<int>(close - data);
+
+                // Skip KConfig group flags like [$i]
+                if (data[p + 1] != '$') {
+                    if (!key.isEmpty()) {
+                        m_groups[key];
+                        key += GroupSeparator;
+                    }
+                    key.append(data + p + 1, closePos - p - 1);
+                }
+                p = closePos + 1;
+            }
+
+            currentKey = key;
+            Group& group = m_groups[currentKey];
+            if (!group.declared) {
+                group.declared = true;
+                m_order.append(currentKey);
+            }
+            continue;
+        }
+
+        const char* equals = static_cast<const char*>(std::memchr(data + start, '=', end - start));
+        if (!equals)
+            continue;
+        const int equalsPos = static_cast<int>(equals - data);
+
+        int keyEnd = equalsPos;
+        while (keyEnd > start && isBlank(data[keyEnd - 1])) keyEnd--;
+        QByteArray key(data + start, keyEnd - start);
+
+        // Drop entry flags like key[$e], keep locale suffixes as distinct keys
+        const int flagsPos = key.indexOf("[$");
+        if (flagsPos > 0 && key.endsWith(']'))
+            key.truncate(flagsPos);
+
+        int valueStart = equalsPos + 1;
+        while (valueStart < end && isBlank(data[valueStart])) valueStart++;
+
+        currentEntries.insert(key, Span{valueStart, end - valueStart});
+    }
+
+    flush();
+}
+
+bool PlasmaConfigIndex::hasGroup(const QByteArray& group) const
+{
+    return m_groups.contains(group);
+}
+
+bool PlasmaConfigIndex::hasEntry(const QByteArray& group, const QByteArray& key) const
+{
+    return findEntry(group, key) != nullptr;
+}
+
+QByteArrayList PlasmaConfigIndex::keys(const QByteArray& group) const
+{
+    auto groupIt = m_groups.constFind(group);
+    if (groupIt == m_groups.cend())
+        return {};
+    return groupIt->entries.keys();
+}
+
+const PlasmaConfigIndex::Span* PlasmaConfigIndex::findEntry(const QByteArray& group,
+                                                            const QByteArray& key) const
+{
+    auto groupIt = m_groups.constFind(group);
+    if (groupIt == m_groups.cend())
+        return nullptr;
+
+    auto entryIt = groupIt->entries.constFind(key);
+    if (entryIt == groupIt->entries.cend())
+        return nullptr;
+
+    return &entryIt.value();
+}
+
+QString PlasmaConfigIndex::readEntry(const QByteArray& group, const QByteArray& key,
+                                     const QString& defaultVal) const
+{
+    const Span* span = findEntry(group, key);
+    if (!span)
+        return defaultVal;
+    return QString::fromUtf8(m_data.constData() + span->offset, span->length);
+}
+
+int PlasmaConfigIndex::readInt(const QByteArray& group, const QByteArray& key, int defaultVal) const
+{
+    const Span* span = findEntry(group, key);
+    if (!span)
+        return defaultVal;
+
+    bool ok;
+    int result = QByteArray::fromRawData(m_data.constData() + span->offset, span->length).toInt(&ok);
+    return ok ? result : defaultVal;
+}
+
+bool PlasmaConfigIndex::readBool(const QByteArray& group, const QByteArray& key, bool defaultVal) const
+{
+    const Span* span = findEntry(group, key);
+    if (!span)
+        return defaultVal;
+
+    const QByteArray val = QByteArray::fromRawData(m_data.constData() + span->offset, span->length);
+    return val == "true" || val == "1";
+}
+
+void PlasmaConfigIndex::hashGroup(const QByteArray& group, QCryptographicHash& hash) const
+{
+    auto groupIt = m_groups.constFind(group);
+    if (groupIt == m_groups.cend())
+        return;
+
+    hash.addData(group);
+    hash.addData(QByteArray(1, '\n'));
+
+    // QHash iteration order is not stable between runs, sort for a stable hash
+    QByteArrayList keys = groupIt->entries.keys();
+    std::sort(keys.begin(), keys.end());
+    for (const QByteArray& key : keys) {
+        const Span span = groupIt->entries.value(key);
+        hash.addData(key);
+        hash.addData(QByteArray(1, '='));
+        hash.addData(QByteArray::fromRawData(m_data.constData() + span.offset, span.length));
+        hash.addData(QByteArray(1, '\n'));
+    }
+}
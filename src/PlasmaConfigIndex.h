@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayList>
+#include <QHash>
+#include <QString>
+
+class QCryptographicHash;
+
+// Single-pass index over a KConfig ini file (appletsrc, plasmashellrc).
+// The file is tokenized once; every group header is mapped to its entries,
+// and every entry to the span of its value in the raw file contents.
+// Nested groups like [Containments][1][Applets][5] are keyed by their path
+// joined with KConfig's own group separator (0x1d), see groupKey().
+
+class PlasmaConfigIndex
+{
+public:
+    struct Span {
+        int offset = 0;
+        int length = 0;
+    };
+
+    struct Group {
+        QHash<QByteArray, Span> entries;
+        bool declared = false;  // false for implicit parents of nested groups
+    };
+
+    static PlasmaConfigIndex fromFile(const QString& path);
+    static PlasmaConfigIndex fromData(const QByteArray& data);
+
+    static QByteArray groupKey(const QByteArrayList& path);
+    static QByteArrayList groupPath(const QByteArray& key);
+
+    bool isLoaded() const { return m_loaded; }
+
+    // Declared groups in file order
+    const QByteArrayList& groups() const { return m_order; }
+
+    bool hasGroup(const QByteArray& group) const;
+    bool hasEntry(const QByteArray& group, const QByteArray& key) const;
+    QByteArrayList keys(const QByteArray& group) const;
+
+    QString readEntry(const QByteArray& group, const QByteArray& key,
+                      const QString& defaultVal = QString()) const;
+    int readInt(const QByteArray& group, const QByteArray& key, int defaultVal) const;
+    bool readBool(const QByteArray& group, const QByteArray& key, bool defaultVal) const;
+
+    // Feed a group's name and entries (in key order) into a content hash
+    void hashGroup(const QByteArray& group, QCryptographicHash& hash) const;
+
+private:
+    void parse();
+    const Span* findEntry(const QByteArray& group, const QByteArray& key) const;
+
+    QByteArray m_data;
+    QHash<QByteArray, Group> m_groups;
+    QByteArrayList m_order;
+    bool m_loaded = false;
+};
@@ -0,0 +1,112 @@
+#include "PlasmaConfigSnapshot.h"
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QElapsedTimer>
+
+ConfigFileStamp ConfigFileStamp::of(const QString& path)
+{
+    ConfigFileStamp stamp;
+    QFileInfo info(path);
+    if (info.exists()) {
+        stamp.modified = info.lastModified().toMSecsSinceEpoch();
+        stamp.size = info.size();
+    }
+    return stamp;
+}
+
+PlasmaConfigSnapshot PlasmaConfigSnapshot::load()
+{
+    return load(configLocation());
+}
+
+PlasmaConfigSnapshot PlasmaConfigSnapshot::load(const QString& configDir)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const QString appletsrc = appletsrcPath(configDir);
+    const QString plasmashellrc = plasmashellrcPath(configDir);
+
+    PlasmaConfigSnapshot snapshot;
+    snapshot.m_appletsrcStamp = ConfigFileStamp::of(appletsrc);
+    snapshot.m_plasmashellrcStamp = ConfigFileStamp::of(plasmashellrc);
+    snapshot.m_appletsrc = PlasmaConfigIndex::fromFile(appletsrc);
+    snapshot.m_plasmashellrc = PlasmaConfigIndex::fromFile(plasmashellrc);
+    snapshot.m_panels = PlasmaPanelMap::fromIndex(snapshot.m_appletsrc, snapshot.m_plasmashellrc);
+    snapshot.m_fingerprint = snapshot.computeFingerprint();
+    snapshot.m_loadTimeNs = timer.nsecsElapsed();
+    return snapshot;
+}
+
+QString PlasmaConfigSnapshot::configLocation()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::ConfigLocation);
+}
+
+QString PlasmaConfigSnapshot::appletsrcPath(const QString& configDir)
+{
+    return configDir + "/plasma-org.kde.plasma.desktop-appletsrc";
+}
+
+QString PlasmaConfigSnapshot::plasmashellrcPath(const QString& configDir)
+{
+    return configDir + "/plasmashellrc";
+}
+
+KDEClockConfig PlasmaConfigSnapshot::clockConfig() const
+{
+    if (!m_appletsrc.isLoaded()) {
+        return KDEClockConfig();
+    }
+    return KDEClockConfig::fromApplet(m_appletsrc, m_panels.clockApplet());
+}
+
+KDEPanelConfig PlasmaConfigSnapshot::panelConfig() const
+{
+    return KDEPanelConfig::fromPanels(m_panels);
+}
+
+QHash<QString, KDEPanelConfig> PlasmaConfigSnapshot::screenPanels() const
+{
+    QHash<QString, KDEPanelConfig> screens;
+    for (const QString& connector : m_panels.screenConnectors()) {
+        if (const PlasmaPanelMap::Panel* panel = m_panels.panelForScreen(connector)) {
+            screens.insert(connector, panel->config);
+        }
+    }
+    return screens;
+}
+
+QByteArray PlasmaConfigSnapshot::computeFingerprint() const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    for (const QByteArray& group : m_appletsrc.groups()) {
+        const QByteArrayList path = PlasmaConfigIndex::groupPath(group);
+        if (path.size() < 2 || path[0] != "Containments")
+            continue;
+
+        const QString plugin = m_appletsrc.readEntry(group, "plugin");
+        if (path.size() == 2 && plugin == "org.kde.panel") {
+            m_appletsrc.hashGroup(group, hash);
+        } else if (path.size() == 4 && path[2] == "Applets" &&
+                   plugin == "org.kde.plasma.digitalclock") {
+            m_appletsrc.hashGroup(group, hash);
+            m_appletsrc.hashGroup(
+                PlasmaConfigIndex::groupKey(path + QByteArrayList{"Configuration", "Appearance"}),
+                hash);
+        }
+    }
+
+    for (const QByteArray& group : m_plasmashellrc.groups()) {
+        const QByteArrayList path = PlasmaConfigIndex::groupPath(group);
+        if ((path.size() >= 2 && path[0] == "PlasmaViews" && path[1].startsWith("Panel ")) ||
+            (path.size() == 1 && path[0] == "ScreenConnectors")) {
+            m_plasmashellrc.hashGroup(group, hash);
+        }
+    }
+
+    return hash.result();
+}
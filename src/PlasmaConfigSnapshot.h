@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include "KDEClockConfig.h"
+#include "PlasmaConfigIndex.h"
+#include "PlasmaPanelMap.h"
+
+// Modification time and size of a config file, used to tell whether it
+// changed without reading it
+struct ConfigFileStamp {
+    qint64 modified = -1;
+    qint64 size = -1;
+
+    static ConfigFileStamp of(const QString& path);
+    bool operator==(const ConfigFileStamp& other) const {
+        return modified == other.modified && size == other.size;
+    }
+    bool operator!=(const ConfigFileStamp& other) const { return !(*this == other); }
+};
+
+// One read of Plasma's config files: appletsrc and plasmashellrc are read
+// and indexed once, and both the clock and panel settings come from it.
+
+class PlasmaConfigSnapshot
+{
+public:
+    static PlasmaConfigSnapshot load();
+    // Same files from another directory, e.g. a copy of someone's config
+    static PlasmaConfigSnapshot load(const QString& configDir);
+
+    static QString appletsrcPath(const QString& configDir = configLocation());
+    static QString plasmashellrcPath(const QString& configDir = configLocation());
+    static QString configLocation();
+
+    // Stamps taken right before the files were read
+    const ConfigFileStamp& appletsrcStamp() const { return m_appletsrcStamp; }
+    const ConfigFileStamp& plasmashellrcStamp() const { return m_plasmashellrcStamp; }
+
+    const PlasmaConfigIndex& appletsrc() const { return m_appletsrc; }
+    const PlasmaConfigIndex& plasmashellrc() const { return m_plasmashellrc; }
+    const PlasmaPanelMap& panels() const { return m_panels; }
+
+    KDEClockConfig clockConfig() const;
+    KDEPanelConfig panelConfig() const;
+
+    // Panel for each screen connector that has one, see PlasmaPanelMap
+    QHash<QString, KDEPanelConfig> screenPanels() const;
+
+    // Hash over the config groups this app reads: panel containments, the
+    // digitalclock applets and their Appearance settings, the PlasmaViews
+    // panel groups and the screen connector mapping. Unrelated writes (desktop icons, other
+    // applets) leave it unchanged.
+    const QByteArray& fingerprint() const { return m_fingerprint; }
+
+    // Time load() spent reading, indexing and hashing the files
+    qint64 loadTimeNs() const { return m_loadTimeNs; }
+
+private:
+    QByteArray computeFingerprint() const;
+
+    ConfigFileStamp m_appletsrcStamp;
+    ConfigFileStamp m_plasmashellrcStamp;
+    PlasmaConfigIndex m_appletsrc;
+    PlasmaConfigIndex m_plasmashellrc;
+    PlasmaPanelMap m_panels;
+    QByteArray m_fingerprint;
+    qint64 m_loadTimeNs = 0;
+};
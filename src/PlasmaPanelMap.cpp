@@ -0,0 +1,120 @@
+#include "PlasmaPanelMap.h"
+#include "PlasmaConfigIndex.h"
+
+static const QString PanelPlugin = QStringLiteral("org.kde.panel");
+static const QString ClockPlugin = QStringLiteral("org.kde.plasma.digitalclock");
+
+PlasmaPanelMap PlasmaPanelMap::fromIndex(const PlasmaConfigIndex& applets,
+                                         const PlasmaConfigIndex& shell)
+{
+    PlasmaPanelMap map;
+
+    // First clock applet per containment; applets may be listed before
+    // their containment, so they are matched up after the pass
+    QHash<QByteArray, QByteArrayList> clocks;
+    QByteArrayList firstClock;
+
+    for (const QByteArray& group : applets.groups()) {
+        const QByteArrayList path = PlasmaConfigIndex::groupPath(group);
+        if (path.size() < 2 || path[0] != "Containments") {
+            continue;
+        }
+
+        if (path.size() == 2) {
+            if (applets.readEntry(group, "plugin") != PanelPlugin) {
+                continue;
+            }
+
+            Panel panel;
+            panel.containment = path[1];
+            panel.config.location = applets.readInt(group, "location", 4);
+            panel.config.screen = applets.readInt(group, "lastScreen", 0);
+            map.m_byContainment.insert(panel.containment, map.m_panels.size());
+            map.m_panels.append(panel);
+        } else if (path.size() == 4 && path[2] == "Applets" &&
+                   applets.readEntry(group, "plugin") == ClockPlugin) {
+            if (!clocks.contains(path[1])) {
+                clocks.insert(path[1], path);
+            }
+            if (firstClock.isEmpty()) {
+                firstClock = path;
+            }
+        }
+    }
+
+    for (int i = 0; i < map.m_panels.size(); i++) {
+        Panel& panel = map.m_panels[i];
+        panel.clockApplet = clocks.value(panel.containment);
+
+        if (panel.hasClock() && map.m_clockPanel < 0) {
+            map.m_clockPanel = i;
+        }
+
+        // Prefer the panel hosting a clock for its screen
+        auto byScreen = map.m_byScreen.constFind(panel.config.screen);
+        if (byScreen == map.m_byScreen.cend() ||
+            (panel.hasClock() && !map.m_panels[byScreen.value()].hasClock())) {
+            map.m_byScreen.insert(panel.config.screen, i);
+        }
+    }
+
+    map.m_clockApplet = map.m_clockPanel >= 0 ? map.m_panels[map.m_clockPanel].clockApplet
+                                              : firstClock;
+
+    for (const QByteArray& group : shell.groups()) {
+        const QByteArrayList path = PlasmaConfigIndex::groupPath(group);
+
+        // [ScreenConnectors] maps Plasma's screen ids to output names
+        if (path.size() == 1 && path[0] == "ScreenConnectors") {
+            for (const QByteArray& id : shell.keys(group)) {
+                bool ok;
+                const int screen = id.toInt(&ok);
+                if (ok) {
+                    map.m_screenIds.insert(shell.readEntry(group, id), screen);
+                }
+            }
+            continue;
+        }
+
+        // [PlasmaViews][Panel N] and [PlasmaViews][Panel N][Defaults]
+        if (path.size() < 2 || path[0] != "PlasmaViews" || !path[1].startsWith("Panel ")) {
+            continue;
+        }
+
+        auto it = map.m_byContainment.constFind(path[1].mid(6));
+        if (it == map.m_byContainment.cend()) {
+            continue;
+        }
+        KDEPanelConfig& config = map.m_panels[it.value()].config;
+
+        if (path.size() == 2) {
+            config.floating = shell.readBool(group, "floating", false);
+        } else if (path.size() == 3 && path[2] == "Defaults") {
+            config.thickness = shell.readInt(group, "thickness", 44);
+        }
+    }
+
+    return map;
+}
+
+const PlasmaPanelMap::Panel* PlasmaPanelMap::panel(const QByteArray& containment) const
+{
+    auto it = m_byContainment.constFind(containment);
+    return it != m_byContainment.cend() ? &m_panels[it.value()] : nullptr;
+}
+
+const PlasmaPanelMap::Panel* PlasmaPanelMap::clockPanel() const
+{
+    return m_clockPanel >= 0 ? &m_panels[m_clockPanel] : nullptr;
+}
+
+const PlasmaPanelMap::Panel* PlasmaPanelMap::panelForScreen(const QString& connector) const
+{
+    auto screen = m_screenIds.constFind(connector);
+    if (screen == m_screenIds.cend()) {
+        return nullptr;
+    }
+
+    auto it = m_byScreen.constFind(screen.value());
+    return it != m_byScreen.cend() ? &m_panels[it.value()] : nullptr;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayList>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include "KDEClockConfig.h"
+
+class PlasmaConfigIndex;
+
+// Every Plasma panel resolved in one pass over appletsrc and plasmashellrc:
+// containment id, screen, location, thickness, floating state and the
+// digitalclock applet it hosts, if any. Panels are looked up by containment
+// id or by screen connector name through hashes, so the cost of a lookup
+// does not grow with the number of containments.
+
+class PlasmaPanelMap
+{
+public:
+    struct Panel {
+        QByteArray containment;
+        KDEPanelConfig config;
+        QByteArrayList clockApplet;  // [Containments][N][Applets][M], empty if none
+
+        bool hasClock() const { return !clockApplet.isEmpty(); }
+    };
+
+    static PlasmaPanelMap fromIndex(const PlasmaConfigIndex& appletsrc,
+                                    const PlasmaConfigIndex& plasmashellrc);
+
+    // Panels in file order
+    const QList<Panel>& panels() const { return m_panels; }
+
+    const Panel* panel(const QByteArray& containment) const;
+
+    // The panel hosting the digital clock, the first such one if several do
+    const Panel* clockPanel() const;
+
+    // Best panel on the screen with this connector name (e.g. "DP-1"):
+    // the one hosting a clock, otherwise the first panel there
+    const Panel* panelForScreen(const QString& connector) const;
+    QStringList screenConnectors() const { return m_screenIds.keys(); }
+
+    // Clock applet to read Appearance settings from: the clock panel's,
+    // or a clock placed elsewhere (e.g. on the desktop) if no panel has one
+    const QByteArrayList& clockApplet() const { return m_clockApplet; }
+
+private:
+    QList<Panel> m_panels;
+    QHash<QByteArray, int> m_byContainment;
+    QHash<int, int> m_byScreen;
+    QHash<QString, int> m_screenIds;
+    int m_clockPanel = -1;
+    QByteArrayList m_clockApplet;
+};
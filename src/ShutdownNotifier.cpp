@@ -0,0 +1,67 @@
+#include "ShutdownNotifier.h"
+#include <QCoreApplication>
+#include <QSocketNotifier>
+#include <QDebug>
+
+#ifdef Q_OS_LINUX
+#include <csignal>
+#include <sys/signalfd.h>
+#include <unistd.h>
+
+static sigset_t quitSignals()
+{
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGTERM);
+    sigaddset(&mask, SIGINT);
+    return mask;
+}
+#endif
+
+void ShutdownNotifier::blockQuitSignals()
+{
+#ifdef Q_OS_LINUX
+    const sigset_t mask = quitSignals();
+    sigprocmask(SIG_BLOCK, &mask, nullptr);
+#endif
+}
+
+ShutdownNotifier::ShutdownNotifier(QObject *parent)
+    : QObject(parent)
+    , m_signalFd(-1)
+    , m_notifier(nullptr)
+{
+#ifdef Q_OS_LINUX
+    const sigset_t mask = quitSignals();
+    m_signalFd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (m_signalFd >= 0) {
+        m_notifier = new QSocketNotifier(m_signalFd, QSocketNotifier::Read, this);
+        connect(m_notifier, &QSocketNotifier::activated,
+                this, &ShutdownNotifier::onSignal);
+    } else {
+        qWarning("Could not set up SIGTERM handling");
+    }
+#endif
+}
+
+ShutdownNotifier::~ShutdownNotifier()
+{
+#ifdef Q_OS_LINUX
+    if (m_signalFd >= 0) {
+        close(m_signalFd);
+    }
+#endif
+}
+
+void ShutdownNotifier::onSignal()
+{
+#ifdef Q_OS_LINUX
+    struct signalfd_siginfo info;
+    if (read(m_signalFd, &info, sizeof(info)) != sizeof(info)) {
+        return;
+    }
+
+    qDebug() << "Quitting on signal" << info.ssi_signo;
+    QCoreApplication::quit();
+#endif
+}
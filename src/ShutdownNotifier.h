@@ -0,0 +1,29 @@
+#pragma once
+
+#include <QObject>
+
+class QSocketNotifier;
+
+// Turns SIGTERM (session logout) and SIGINT into QCoreApplication::quit(),
+// so a killed clock still runs aboutToQuit and its destructors. The
+// signals are blocked and read from a signalfd through a QSocketNotifier;
+// blockQuitSignals() must run before any thread is started so that every
+// thread inherits the mask.
+
+class ShutdownNotifier : public QObject
+{
+    Q_OBJECT
+
+public:
+    static void blockQuitSignals();
+
+    explicit ShutdownNotifier(QObject *parent = nullptr);
+    ~ShutdownNotifier() override;
+
+private slots:
+    void onSignal();
+
+private:
+    int m_signalFd;
+    QSocketNotifier* m_notifier;
+};
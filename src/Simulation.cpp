@@ -0,0 +1,209 @@
+#include "Simulation.h"
+#include "ClockFormatter.h"
+#include "ClockLayout.h"
+#include "ClockSource.h"
+#include "ClockWindow.h"
+#include "ExposureMap.h"
+#include "PlasmaConfigSnapshot.h"
+#include "TickScheduler.h"
+#include "Wakeups.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGuiApplication>
+#include <QLoggingCategory>
+#include <QScreen>
+#include <QSettings>
+#include <QTextStream>
+#include <QtNumeric>
+#include <cstring>
+#include <memory>
+
+bool Simulation::parseArguments(int argc, char *argv[], Options& options)
+{
+    bool simulate = false;
+
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--simulate") == 0) {
+            // A missing or unparsable value still selects the simulation,
+            // with days left at 0 for the caller to reject
+            simulate = true;
+            bool ok = false;
+            options.days = hasValue ? QString(argv[++i]).toDouble(&ok) : 0.0;
+            if (!ok || !qIsFinite(options.days)) {
+                options.days = 0.0;
+            }
+        } else if (std::strcmp(argv[i], "--output") == 0 && hasValue) {
+            options.outputDir = QString::fromLocal8Bit(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            options.seed = QString(argv[++i]).toUInt();
+        } else if (std::strcmp(argv[i], "--screen") == 0 && hasValue) {
+            const QStringList size = QString(argv[++i]).split('x');
+            if (size.size() == 2) {
+                options.screenSize = QSize(size[0].toInt(), size[1].toInt());
+            }
+        } else if (std::strcmp(argv[i], "--config") == 0 && hasValue) {
+            options.configDir = QString::fromLocal8Bit(argv[++i]);
+        } else if (std::strcmp(argv[i], "--placement") == 0 && hasValue) {
+            const QString placement(argv[++i]);
+            if (placement == "wear-leveling") {
+                options.placement = ClockOutput::WearLevelingPlacement;
+            } else if (placement == "low-discrepancy") {
+                options.placement = ClockOutput::LowDiscrepancyPlacement;
+            } else {
+                options.placement = ClockOutput::RandomPlacement;
+            }
+        }
+    }
+
+    return simulate;
+}
+
+int Simulation::run(int argc, char *argv[], const Options& options)
+{
+    QDir().mkpath(options.outputDir);
+    const QString outputDir = QDir(options.outputDir).absolutePath();
+
+    // One offscreen screen of the requested size stands in for the output
+    const QString screenConfig = outputDir + "/screen.json";
+    QFile screenFile(screenConfig);
+    if (screenFile.open(QIODevice::WriteOnly)) {
+        screenFile.write(QString("{ \"screens\": [ { \"name\": \"SIM-1\", \"x\": 0, \"y\": 0, "
+                                 "\"width\": %1, \"height\": %2, \"logicalDpi\": 96, \"dpr\": 1 } ] }\n")
+                             .arg(options.screenSize.width())
+                             .arg(options.screenSize.height())
+                             .toUtf8());
+        screenFile.close();
+    }
+    qputenv("QT_QPA_PLATFORM", ("offscreen:configfile=" + screenConfig).toLocal8Bit());
+
+    QGuiApplication app(argc, argv);
+    app.setOrganizationName("Ustek");
+    app.setApplicationName("plasma-clock-oled");
+
+    // Per-move logging would dominate the run
+    QLoggingCategory::setFilterRules("default.debug=false");
+
+    // Fresh, private state: exposure history and sequence phase must not
+    // come from (or leak into) the real session
+    QDir(outputDir + "/exposure").removeRecursively();
+    QFile::remove(outputDir + "/Ustek/plasma-clock-oled.conf");
+    ExposureMap::setDirectory(outputDir + "/exposure");
+    QSettings::setPath(QSettings::NativeFormat, QSettings::UserScope, outputDir);
+
+    // Defaults keep runs comparable across machines; --config reads a copy
+    // of Plasma's config files instead of the session's own
+    KDEClockConfig clockConfig;
+    KDEPanelConfig panelConfig;
+    if (!options.configDir.isEmpty()) {
+        const PlasmaConfigSnapshot snapshot = PlasmaConfigSnapshot::load(options.configDir);
+        clockConfig = snapshot.clockConfig();
+        panelConfig = snapshot.panelConfig();
+    }
+    QScreen* screen = QGuiApplication::primaryScreen();
+    const ClockLayout layout = ClockLayout::compute(clockConfig, panelConfig,
+                                                    screen->devicePixelRatio());
+
+    // Fixed start for reproducible runs
+    VirtualClock clock(QDateTime(QDate(2026, 1, 5), QTime(0, 0)));
+    ClockSource::install(&clock);
+    Wakeups::reset();
+
+    ClockFormatter formatter(clockConfig);
+
+    auto outputPtr = std::make_unique<ClockOutput>([]() { return new ClockWindow(); }, screen);
+    ClockOutput& output = *outputPtr;
+    output.setHeadless(true);
+    output.setRandomSeed(options.seed);
+    output.setPlacement(options.placement);
+    output.setup(clockConfig, panelConfig, layout);
+    output.setText(formatter.formatTime(clock.now().time()),
+                   clockConfig.showDate ? formatter.formatDate(clock.now().date()) : QString());
+
+    QFile positionsFile(outputDir + "/positions.csv");
+    positionsFile.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    QTextStream positions(&positionsFile);
+    positions << "ms,x,y\n";
+    positions << 0 << ',' << output.position().x() << ',' << output.position().y() << '\n';
+
+    quint64 repaints = 0, moves = 0;
+    QObject::connect(&output, &ClockOutput::moved, &output, [&]() {
+        moves++;
+        positions << clock.monotonicMs() << ',' << output.position().x() << ','
+                  << output.position().y() << '\n';
+    });
+
+    TickScheduler scheduler;
+    scheduler.setGranularity(formatter.showsSeconds() ? TickScheduler::Second
+                                                      : TickScheduler::Minute);
+    QObject::connect(&scheduler, &TickScheduler::tick, &output, [&]() {
+        const QDateTime now = clock.now();
+        const QString date = clockConfig.showDate ? formatter.formatDate(now.date()) : QString();
+        if (output.setText(formatter.formatTime(now.time()), date)) {
+            repaints++;
+        }
+    });
+
+    QElapsedTimer wallTimer;
+    wallTimer.start();
+
+    // Every tick and move is fired by its own timer on the way
+    const qint64 endMs = static_cast<qint64>(options.days * 24 * 3600 * 1000);
+    scheduler.start();
+    output.show();
+    clock.advance(endMs);
+    scheduler.stop();
+    output.accountExposure();
+    positions.flush();
+
+    const qint64 wallMs = wallTimer.elapsed();
+
+    // Exposure statistics over every cell the clock ever lit
+    const ExposureMap& exposure = output.exposure();
+    quint32 worst = 0;
+    quint64 total = 0, lit = 0;
+    for (int y = 0; y < exposure.size().height(); y++) {
+        const quint32* row = exposure.row(y);
+        for (int x = 0; x < exposure.size().width(); x++) {
+            if (row[x] > 0) {
+                worst = qMax(worst, row[x]);
+                total += row[x];
+                lit++;
+            }
+        }
+    }
+    const double mean = lit ? double(total) / lit : 0.0;
+
+    exposure.toImage().save(outputDir + "/heatmap.png");
+
+    const char* placementNames[] = { "random", "wear-leveling", "low-discrepancy" };
+    const double minutes = endMs / 60000.0;
+
+    QString summary;
+    QTextStream out(&summary);
+    out << "placement:            " << placementNames[options.placement] << '\n'
+        << "simulated days:       " << options.days << '\n'
+        << "wall time:            " << wallMs << " ms\n"
+        << "panel:                " << exposure.size().width() << 'x'
+        << exposure.size().height() << '\n'
+        << "ticks:                " << scheduler.tickCount() << '\n'
+        << "repaints:             " << repaints << '\n'
+        << "repositions:          " << moves << '\n'
+        << "wakeups per minute:   " << (minutes > 0 ? Wakeups::total() / minutes : 0.0) << '\n'
+        << "worst pixel exposure: " << worst / 255.0 << " s at full alpha\n"
+        << "mean lit exposure:    " << mean / 255.0 << " s at full alpha\n"
+        << "worst / mean:         " << (mean > 0 ? worst / mean : 0.0) << '\n';
+
+    QFile summaryFile(outputDir + "/summary.txt");
+    if (summaryFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        summaryFile.write(summary.toUtf8());
+    }
+    QTextStream(stdout) << summary;
+
+    // The output records its last exposure on destruction, still in virtual time
+    outputPtr.reset();
+    ClockSource::install(nullptr);
+    return 0;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QSize>
+#include <QString>
+#include "ClockOutput.h"
+
+// Headless, accelerated run of the clock for evaluating placement policies
+// and tick scheduling without a Wayland session. The offscreen QPA stands
+// in for the compositor, layer shell is skipped, and a VirtualClock jumps
+// straight from one timer expiry to the next, so simulated days take
+// seconds. A real TickScheduler and ClockOutput run on that clock, their
+// timers included; ClockController itself is not run, the tick does what
+// its updateTime() does for one output. Wakeups are the recorded ones.
+// The per-pixel exposure heatmap, every position and a summary are written
+// to the output directory.
+
+class Simulation
+{
+public:
+    struct Options {
+        double days = 7.0;
+        QString outputDir = "simulation";
+        ClockOutput::Placement placement = ClockOutput::RandomPlacement;
+        quint32 seed = 1;
+        QSize screenSize = QSize(1920, 1080);
+        QString configDir;  // empty: default clock on a default bottom panel
+    };
+
+    // True if --simulate was given, valid or not; fills options from the
+    // other flags. days is 0 if its value is missing or not a number.
+    static bool parseArguments(int argc, char *argv[], Options& options);
+
+    static int run(int argc, char *argv[], const Options& options);
+};
@@ -0,0 +1,140 @@
+#include "StartupCache.h"
+#include "Config.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFont>
+#include <QFontInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QDebug>
+
+static constexpr quint32 CacheMagic = 0x4f434c4b;  // "OCLK"
+static constexpr quint32 CacheVersion = 2;
+
+static QDataStream& operator<<(QDataStream& out, const KDEPanelConfig& panel)
+{
+    return out << panel.location << panel.thickness << panel.floating << panel.screen;
+}
+
+static QDataStream& operator>>(QDataStream& in, KDEPanelConfig& panel)
+{
+    return in >> panel.location >> panel.thickness >> panel.floating >> panel.screen;
+}
+
+QString StartupCache::path()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/startup.cache";
+}
+
+QString StartupCache::fontFamily()
+{
+    return QFontInfo(QFont(QString::fromLatin1(Config::FontFamily))).family();
+}
+
+bool StartupCache::load(qreal devicePixelRatio, Entry& entry)
+{
+    QFile file(path());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 size = file.size();
+    uchar* data = file.map(0, size);
+    if (!data) {
+        return false;
+    }
+
+    QDataStream in(QByteArray::fromRawData(reinterpret_cast<const char*>(data), size));
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0, version = 0;
+    in >> magic >> version;
+
+    bool ok = false;
+    if (magic == CacheMagic && version == CacheVersion) {
+        in >> entry.appletsrc.modified >> entry.appletsrc.size
+           >> entry.plasmashellrc.modified >> entry.plasmashellrc.size
+           >> entry.fontFamily >> entry.devicePixelRatio >> entry.fingerprint;
+
+        KDEClockConfig& clock = entry.clockConfig;
+        in >> clock.showDate >> clock.dateFormat >> clock.customDateFormat
+           >> clock.showSeconds >> clock.use24hFormat >> clock.dateDisplayFormat;
+
+        in >> entry.panelConfig;
+
+        quint32 screenCount = 0;
+        in >> screenCount;
+        for (quint32 i = 0; i < screenCount && in.status() == QDataStream::Ok; i++) {
+            QString connector;
+            KDEPanelConfig panel;
+            in >> connector >> panel;
+            entry.screenPanels.insert(connector, panel);
+        }
+
+        ClockLayout& layout = entry.layout;
+        in >> layout.timeFontSize >> layout.dateFontSize
+           >> layout.timeCapHeight >> layout.dateCapHeight;
+
+        ok = in.status() == QDataStream::Ok;
+    }
+
+    file.unmap(data);
+    file.close();
+
+    if (!ok) {
+        qDebug() << "Startup cache unreadable, ignoring";
+        return false;
+    }
+
+    // Only valid for the exact files, font and scale it was computed for
+    if (entry.appletsrc != ConfigFileStamp::of(PlasmaConfigSnapshot::appletsrcPath()) ||
+        entry.plasmashellrc != ConfigFileStamp::of(PlasmaConfigSnapshot::plasmashellrcPath()) ||
+        entry.fontFamily != fontFamily() ||
+        !qFuzzyCompare(entry.devicePixelRatio, devicePixelRatio) ||
+        !entry.layout.isValid()) {
+        qDebug() << "Startup cache is stale";
+        return false;
+    }
+
+    return true;
+}
+
+void StartupCache::save(const Entry& entry)
+{
+    const QString cachePath = path();
+    QDir().mkpath(QFileInfo(cachePath).absolutePath());
+
+    QSaveFile file(cachePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Could not write startup cache:" << cachePath;
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+
+    out << CacheMagic << CacheVersion;
+    out << entry.appletsrc.modified << entry.appletsrc.size
+        << entry.plasmashellrc.modified << entry.plasmashellrc.size
+        << entry.fontFamily << entry.devicePixelRatio << entry.fingerprint;
+
+    const KDEClockConfig& clock = entry.clockConfig;
+    out << clock.showDate << clock.dateFormat << clock.customDateFormat
+        << clock.showSeconds << clock.use24hFormat << clock.dateDisplayFormat;
+
+    out << entry.panelConfig;
+
+    out << quint32(entry.screenPanels.size());
+    for (auto it = entry.screenPanels.cbegin(); it != entry.screenPanels.cend(); ++it) {
+        out << it.key() << it.value();
+    }
+
+    const ClockLayout& layout = entry.layout;
+    out << layout.timeFontSize << layout.dateFontSize
+        << layout.timeCapHeight << layout.dateCapHeight;
+
+    file.commit();
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include "ClockLayout.h"
+#include "KDEClockConfig.h"
+#include "PlasmaConfigSnapshot.h"
+
+// Binary cache of the parsed Plasma config and the computed clock layout,
+// stored in $XDG_CACHE_HOME and memory-mapped on startup. An entry is only
+// used while appletsrc and plasmashellrc still have the mtime/size it was
+// built from and the font family and device pixel ratio match, so a warm
+// start shows the clock without parsing config or searching font sizes.
+
+class StartupCache
+{
+public:
+    struct Entry {
+        ConfigFileStamp appletsrc;
+        ConfigFileStamp plasmashellrc;
+        QString fontFamily;
+        qreal devicePixelRatio = 1.0;
+        QByteArray fingerprint;
+        KDEClockConfig clockConfig;
+        KDEPanelConfig panelConfig;
+        QHash<QString, KDEPanelConfig> screenPanels;
+        ClockLayout layout;
+    };
+
+    static QString path();
+
+    // What Config::FontFamily resolves to, so installing or removing fonts
+    // invalidates the cached layout
+    static QString fontFamily();
+
+    // Loads the entry if it matches the current config files, font and DPR
+    static bool load(qreal devicePixelRatio, Entry& entry);
+    static void save(const Entry& entry);
+};
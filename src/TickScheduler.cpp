@@ -0,0 +1,102 @@
+#include "TickScheduler.h"
+#include "ClockChangeNotifier.h"
+#include "ClockSource.h"
+#include "Config.h"
+#include "Wakeups.h"
+
+TickScheduler::TickScheduler(QObject *parent)
+    : QObject(parent)
+    , m_granularity(Minute)
+    , m_tickCount(0)
+    , m_wakeupCount(0)
+{
+    m_jitter.fill(0);
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &ClockTimer::timeout, this, &TickScheduler::onTimeout);
+
+    auto* notifier = new ClockChangeNotifier(this);
+    connect(notifier, &ClockChangeNotifier::clockChanged,
+            this, &TickScheduler::onClockChanged);
+}
+
+void TickScheduler::setGranularity(Granularity granularity)
+{
+    if (granularity == m_granularity) {
+        return;
+    }
+
+    m_granularity = granularity;
+    if (m_timer.isActive()) {
+        arm();
+    }
+}
+
+void TickScheduler::start()
+{
+    arm();
+}
+
+void TickScheduler::stop()
+{
+    m_timer.stop();
+}
+
+int TickScheduler::msUntilNextBoundary(const QTime& now, Granularity granularity)
+{
+    // Day boundaries are minute boundaries too, so this also covers the date
+    const int period = (granularity == Second) ? 1000 : 60000;
+    return period - now.msecsSinceStartOfDay() % period;
+}
+
+void TickScheduler::arm()
+{
+    m_timer.start(msUntilNextBoundary(ClockSource::instance()->now().time(), m_granularity));
+}
+
+QList<quint64> TickScheduler::jitterHistogram() const
+{
+    return QList<quint64>(m_jitter.begin(), m_jitter.end());
+}
+
+void TickScheduler::recordJitter(int lateMs)
+{
+    int bucket = 0;
+    while (bucket < JitterBucketCount - 1 && lateMs >= JitterBucketsMs[bucket]) {
+        bucket++;
+    }
+    m_jitter[bucket]++;
+}
+
+void TickScheduler::onTimeout()
+{
+    m_wakeupCount++;
+    Wakeups::record();
+
+    // The timer runs on the monotonic clock; if the wall clock was slewed
+    // and we woke just before the boundary, wait for the remainder
+    const int remaining = msUntilNextBoundary(ClockSource::instance()->now().time(), m_granularity);
+    if (remaining <= Config::TickEarlyToleranceMs) {
+        m_timer.start(remaining);
+        return;
+    }
+
+    // Time past the boundary we were armed for
+    const int period = (m_granularity == Second) ? 1000 : 60000;
+    recordJitter(period - remaining);
+
+    m_tickCount++;
+    emit tick();
+    arm();
+}
+
+void TickScheduler::onClockChanged()
+{
+    if (!m_timer.isActive()) {
+        return;
+    }
+
+    m_tickCount++;
+    emit tick();
+    arm();
+}
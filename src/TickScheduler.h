@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QList>
+#include <QObject>
+#include <QTime>
+#include <array>
+#include <iterator>
+#include "ClockTimer.h"
+
+// Fires tick() exactly when the displayed time can change: on the next
+// second or minute boundary of the wall clock, depending on whether seconds
+// are shown. A single precise single-shot timer is re-armed for each
+// boundary, so there are no idle wakeups in between and no drift.
+// Clock steps, resume from suspend and timezone changes tick immediately
+// and re-arm the schedule instead of waiting for the next boundary.
+// How late each boundary tick fires is kept in a small histogram.
+
+class TickScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Granularity {
+        Second,
+        Minute
+    };
+
+    explicit TickScheduler(QObject *parent = nullptr);
+
+    void setGranularity(Granularity granularity);
+    Granularity granularity() const { return m_granularity; }
+
+    void start();
+    void stop();
+
+    static int msUntilNextBoundary(const QTime& now, Granularity granularity);
+
+    // Upper bounds of the jitter histogram buckets; the last bucket
+    // collects everything later than the last bound
+    static constexpr int JitterBucketsMs[] = {1, 2, 5, 10, 20, 50, 100};
+    static constexpr int JitterBucketCount = std::size(JitterBucketsMs) + 1;
+
+    quint64 tickCount() const { return m_tickCount; }
+    quint64 wakeupCount() const { return m_wakeupCount; }
+    QList<quint64> jitterHistogram() const;
+
+signals:
+    void tick();
+
+private slots:
+    void onTimeout();
+    void onClockChanged();
+
+private:
+    void arm();
+    void recordJitter(int lateMs);
+
+    ClockTimer m_timer;
+    Granularity m_granularity;
+    quint64 m_tickCount;
+    quint64 m_wakeupCount;
+    std::array<quint64, JitterBucketCount> m_jitter;
+};
@@ -0,0 +1,119 @@
+#include "TrayIconCache.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QGuiApplication>
+#include <QPainter>
+#include <QPalette>
+#include <QPixmap>
+#include <QScreen>
+#include <QStringList>
+#include <QSvgRenderer>
+#include <algorithm>
+
+// Sizes tray hosts commonly ask for, so they never have to rescale
+static constexpr int TraySizes[] = { 16, 22, 24, 32, 48, 64 };
+
+TrayIconCache* TrayIconCache::instance()
+{
+    static TrayIconCache* cache = new TrayIconCache(QCoreApplication::instance());
+    return cache;
+}
+
+TrayIconCache::TrayIconCache(QObject *parent)
+    : QObject(parent)
+    , m_svgLoaded(false)
+{
+}
+
+QString TrayIconCache::themeColor()
+{
+    // Determine icon color based on system theme
+    const QColor windowColor = QGuiApplication::palette().color(QPalette::Window);
+    const bool isDark = windowColor.lightness() < 128;
+    return isDark ? "#eeeeee" : "#232629";
+}
+
+void TrayIconCache::paletteChanged()
+{
+    // Every surface reports the same change, only the first one counts
+    if (m_color.isEmpty() || themeColor() == m_color) {
+        return;
+    }
+    qDebug() << "Palette changed, tray icon color now" << themeColor();
+    emit iconChanged();
+}
+
+QIcon TrayIconCache::icon()
+{
+    const QString color = themeColor();
+    m_color = color;
+
+    QList<qreal> dprs;
+    for (QScreen* screen : QGuiApplication::screens()) {
+        if (!dprs.contains(screen->devicePixelRatio())) {
+            dprs.append(screen->devicePixelRatio());
+        }
+    }
+    if (dprs.isEmpty()) {
+        dprs.append(1.0);
+    }
+    std::sort(dprs.begin(), dprs.end());
+
+    QStringList keyParts{color};
+    for (qreal dpr : dprs) {
+        keyParts.append(QString::number(dpr));
+    }
+    const QString key = keyParts.join('|');
+
+    auto cached = m_icons.constFind(key);
+    if (cached != m_icons.cend()) {
+        return cached.value();
+    }
+
+    const QIcon result = render(color, dprs);
+    m_icons.insert(key, result);
+    return result;
+}
+
+QIcon TrayIconCache::render(const QString& color, const QList<qreal>& dprs)
+{
+    if (!m_svgLoaded) {
+        QFile file(":/plasma-clock-oled.svg");
+        if (file.open(QIODevice::ReadOnly)) {
+            m_svg = file.readAll();
+            file.close();
+        }
+        m_svgLoaded = true;
+    }
+
+    if (m_svg.isEmpty()) {
+        return QIcon::fromTheme("clock", QIcon::fromTheme("preferences-system-time"));
+    }
+
+    // Replace currentColor with theme-appropriate color
+    QByteArray svgContent = m_svg;
+    svgContent.replace("currentColor", color.toLatin1());
+
+    QSvgRenderer renderer(svgContent);
+    QIcon icon;
+
+    for (qreal dpr : dprs) {
+        for (int size : TraySizes) {
+            const int pixels = qRound(size * dpr);
+            QPixmap pixmap(pixels, pixels);
+            pixmap.fill(Qt::transparent);
+
+            QPainter painter(&pixmap);
+            painter.setRenderHint(QPainter::Antialiasing);
+            renderer.render(&painter);
+            painter.end();
+
+            pixmap.setDevicePixelRatio(dpr);
+            icon.addPixmap(pixmap);
+        }
+    }
+
+    return icon;
+}
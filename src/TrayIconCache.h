@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QIcon>
+#include <QObject>
+#include <QString>
+
+// Pre-rendered tray icons shared by every ClockController in the process.
+// The SVG is read once; each theme color is rasterized at every standard
+// tray size for every screen DPR. Entries are keyed by color and survive
+// surface and controller recreation, so switching the theme back and forth
+// renders each color only once.
+
+class TrayIconCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    static TrayIconCache* instance();
+
+    // Icon in the color matching the current palette
+    QIcon icon();
+
+    // Emits iconChanged() if the palette change affects the icon color
+    void paletteChanged();
+
+signals:
+    void iconChanged();
+
+private:
+    explicit TrayIconCache(QObject *parent = nullptr);
+
+    static QString themeColor();
+    QIcon render(const QString& color, const QList<qreal>& dprs);
+
+    QByteArray m_svg;
+    bool m_svgLoaded;
+    QHash<QString, QIcon> m_icons;
+    QString m_color;  // of the last icon handed out
+};
@@ -0,0 +1,73 @@
+#include "Wakeups.h"
+#include "ClockSource.h"
+
+#include <array>
+
+namespace {
+
+constexpr qint64 BucketMs = 1000;
+constexpr int BucketCount = Wakeups::WindowMs / BucketMs;
+
+struct Window {
+    std::array<quint32, BucketCount> counts;
+    std::array<qint64, BucketCount> buckets;  // which second each slot holds
+    quint64 total;
+    qint64 startMs;
+};
+
+Window s_window = {{}, {}, 0, -1};
+
+// Start of counting, set on first use; a clock that went backwards (a
+// VirtualClock installed) starts over
+qint64 startedNow()
+{
+    const qint64 nowMs = ClockSource::instance()->monotonicMs();
+    if (s_window.startMs < 0 || nowMs < s_window.startMs) {
+        Wakeups::reset();
+        s_window.startMs = nowMs;
+    }
+    return nowMs;
+}
+
+}
+
+void Wakeups::record()
+{
+    const qint64 bucket = startedNow() / BucketMs;
+    const int slot = bucket % BucketCount;
+    if (s_window.buckets[slot] != bucket) {
+        s_window.buckets[slot] = bucket;
+        s_window.counts[slot] = 0;
+    }
+    s_window.counts[slot]++;
+    s_window.total++;
+}
+
+quint64 Wakeups::total()
+{
+    return s_window.total;
+}
+
+double Wakeups::perMinute()
+{
+    const qint64 nowMs = startedNow();
+    const qint64 bucket = nowMs / BucketMs;
+
+    quint64 recent = 0;
+    for (int slot = 0; slot < BucketCount; ++slot) {
+        if (s_window.buckets[slot] > bucket - BucketCount && s_window.buckets[slot] <= bucket) {
+            recent += s_window.counts[slot];
+        }
+    }
+
+    const qint64 spanMs = qMin(WindowMs, nowMs - s_window.startMs);
+    return spanMs > 0 ? recent * 60000.0 / spanMs : 0.0;
+}
+
+void Wakeups::reset()
+{
+    s_window.counts.fill(0);
+    s_window.buckets.fill(-1);
+    s_window.total = 0;
+    s_window.startMs = -1;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <QtGlobal>
+
+// Process-wide count of wakeups: every timer expiry and every file, clock
+// or worker event the clock handles, whatever the source, including those
+// that turn out to need no work. Counts are kept per second of monotonic
+// time for the last WindowMs, so the rate follows current behaviour
+// instead of averaging over the whole uptime.
+
+class Wakeups
+{
+public:
+    static constexpr qint64 WindowMs = 5 * 60 * 1000;
+
+    static void record();
+
+    // Since start, or since the last reset()
+    static quint64 total();
+
+    // Over the last WindowMs, or since start if that is shorter
+    static double perMinute();
+
+    // Forget everything, e.g. after installing another ClockSource
+    static void reset();
+};
@@ -1,38 +1,55 @@
 #include <QApplication>
+#include <QGuiApplication>
 #include <QIcon>
 #include <QLockFile>
 #include <QStandardPaths>
 #include <QDir>
-#include <QPointer>
 #include <QDebug>
-#include "ClockWidget.h"
+#include <cstring>
+#include <memory>
+#include "ClockController.h"
+#include "ShutdownNotifier.h"
+#include "Simulation.h"
 
-static QPointer<ClockWidget> g_clock;
-
-static void createClock()
+int main(int argc, char *argv[])
 {
-    qDebug() << "Creating new ClockWidget";
-    g_clock = new ClockWidget();
-    QObject::connect(g_clock, &ClockWidget::recreationRequested, []() {
-        qDebug() << "Recreation requested, scheduling...";
-        // Delete old and create new on next event loop iteration
-        if (g_clock) {
-            g_clock->deleteLater();
+    // --simulate DAYS: headless accelerated run, see Simulation
+    Simulation::Options simulation;
+    if (Simulation::parseArguments(argc, argv, simulation)) {
+        if (simulation.days <= 0) {
+            qCritical("--simulate needs a positive number of days, e.g. --simulate 7");
+            return 1;
         }
-        QMetaObject::invokeMethod(qApp, []() {
-            createClock();
-        }, Qt::QueuedConnection);
-    });
-}
+        return Simulation::run(argc, argv, simulation);
+    }
 
-int main(int argc, char *argv[])
-{
-    QApplication app(argc, argv);
-    app.setOrganizationName("Ustek");
-    app.setApplicationName("plasma-clock-oled");
-    app.setApplicationDisplayName("Plasma Clock OLED");
-    app.setWindowIcon(QIcon(":/plasma-clock-oled.svg"));
-    app.setQuitOnLastWindowClosed(false);  // Keep running, quit from tray
+    // --raster: draw into a QRasterWindow on a plain QGuiApplication,
+    // without the widget stack (and without tray icon and context menu)
+    // --all-screens: one clock per output instead of only the primary one
+    ClockController::Backend backend = ClockController::WidgetBackend;
+    bool allScreens = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--raster") == 0) {
+            backend = ClockController::RasterBackend;
+        } else if (std::strcmp(argv[i], "--all-screens") == 0) {
+            allScreens = true;
+        }
+    }
+
+    // Before QApplication starts any thread, so all of them inherit the mask
+    ShutdownNotifier::blockQuitSignals();
+
+    std::unique_ptr<QGuiApplication> app;
+    if (backend == ClockController::RasterBackend) {
+        app.reset(new QGuiApplication(argc, argv));
+    } else {
+        app.reset(new QApplication(argc, argv));
+    }
+    app->setOrganizationName("Ustek");
+    app->setApplicationName("plasma-clock-oled");
+    app->setApplicationDisplayName("Plasma Clock OLED");
+    app->setWindowIcon(QIcon(":/plasma-clock-oled.svg"));
+    app->setQuitOnLastWindowClosed(false);  // Keep running, quit from tray
 
     // Ensure only one instance runs
     QString lockPath = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
@@ -45,7 +62,9 @@ int main(int argc, char *argv[])
         return 1;
     }
 
-    createClock();
+    // Logout sends SIGTERM; quit normally so state is saved on the way out
+    ShutdownNotifier shutdown;
+    ClockController clock(backend, allScreens);
 
-    return app.exec();
+    return app->exec();
 }
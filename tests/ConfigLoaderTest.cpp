@@ -0,0 +1,73 @@
+#include <QtTest>
+
+#include "ConfigLoader.h"
+#include "TickScheduler.h"
+
+// A config read that blocks for well over a second must not hold up the
+// clock: ticks keep landing on their second boundaries while it runs.
+
+static constexpr int SlowReadMs = 2500;
+
+class ConfigLoaderTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void slowReadKeepsTicking();
+};
+
+void ConfigLoaderTest::initTestCase()
+{
+    // Read from an empty test location instead of the user's config
+    QStandardPaths::setTestModeEnabled(true);
+}
+
+void ConfigLoaderTest::slowReadKeepsTicking()
+{
+    TickScheduler scheduler;
+    scheduler.setGranularity(TickScheduler::Second);
+
+    QList<QTime> ticks;
+    connect(&scheduler, &TickScheduler::tick, this, [&ticks]() {
+        ticks.append(QTime::currentTime());
+    });
+
+    ConfigLoader loader;
+    loader.setLoadFunction([]() {
+        QThread::msleep(SlowReadMs);
+        return PlasmaConfigSnapshot::load();
+    });
+
+    bool loaded = false;
+    connect(&loader, &ConfigLoader::loaded, this, [&loaded]() {
+        loaded = true;
+    });
+
+    // start() only arms the timer for the next boundary; clearing makes
+    // sure only ticks that land while the slow load runs are checked
+    scheduler.start();
+    ticks.clear();
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    loader.request();
+    QTRY_VERIFY_WITH_TIMEOUT(loaded, SlowReadMs * 4);
+
+    QVERIFY(elapsed.elapsed() >= SlowReadMs);
+    QCOMPARE(loader.loadCount(), quint64(1));
+
+    // Ticks kept arriving during the read, one per second, each within
+    // 100 ms of its boundary
+    QVERIFY2(ticks.size() >= SlowReadMs / 1000, qPrintable(QString::number(ticks.size())));
+    for (const QTime& tick : std::as_const(ticks)) {
+        QVERIFY2(tick.msec() < 100, qPrintable(tick.toString(QStringLiteral("hh:mm:ss.zzz"))));
+    }
+    for (qsizetype i = 1; i < ticks.size(); ++i) {
+        QVERIFY(ticks.at(i).second() != ticks.at(i - 1).second());
+    }
+}
+
+QTEST_GUILESS_MAIN(ConfigLoaderTest)
+
+#include "ConfigLoaderTest.moc"
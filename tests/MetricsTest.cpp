@@ -0,0 +1,173 @@
+#include <QtTest>
+#include <QDBusArgument>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+
+#include "ClockSource.h"
+#include "MetricsAdaptor.h"
+#include "MetricsSource.h"
+#include "Wakeups.h"
+
+// MetricsAdaptor read back over a real bus, as a monitoring client sees
+// it, and the sliding window behind WakeupsPerMinute. ctest runs this
+// under dbus-run-session, so it never touches the desktop session bus.
+
+static const char Service[] = "org.ustek.PlasmaClockOled.Test";
+static const char Path[] = "/org/ustek/PlasmaClockOled";
+
+class FakeMetrics : public QObject, public MetricsSource
+{
+    Q_OBJECT
+
+public:
+    quint64 tickCount() const override { return ticks; }
+    QList<quint64> jitterHistogram() const override { return jitter; }
+    quint64 wakeupCount() const override { return wakeups; }
+    double wakeupsPerMinute() const override { return wakeupRate; }
+    quint64 repaintCount() const override { return repaints; }
+    quint64 repaintsSkipped() const override { return skipped; }
+    qint64 paintTimeNs() const override { return paintNs; }
+    quint64 pixelsPainted() const override { return pixels; }
+    quint64 configLoadCount() const override { return 0; }
+    qint64 lastConfigLoadTimeNs() const override { return 0; }
+    qint64 totalConfigLoadTimeNs() const override { return 0; }
+    quint64 configEventsSkipped() const override { return eventsSkipped; }
+    quint64 configSnapshotsSkipped() const override { return snapshotsSkipped; }
+    quint64 repositionCount() const override { return repositions; }
+    QPoint position() const override { return pos; }
+    qint64 uptimeMs() const override { return 0; }
+
+    quint64 ticks = 0;
+    QList<quint64> jitter;
+    quint64 wakeups = 0;
+    double wakeupRate = 0.0;
+    quint64 repaints = 0;
+    quint64 skipped = 0;
+    qint64 paintNs = 0;
+    quint64 pixels = 0;
+    quint64 eventsSkipped = 0;
+    quint64 snapshotsSkipped = 0;
+    quint64 repositions = 0;
+    QPoint pos;
+};
+
+class MetricsTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void properties();
+    void wakeupWindow();
+
+private:
+    void readAll(QVariantMap& values);
+
+    FakeMetrics m_metrics;
+};
+
+void MetricsTest::initTestCase()
+{
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    QVERIFY2(bus.isConnected(), "No session bus, run under dbus-run-session");
+
+    new MetricsAdaptor(&m_metrics, &m_metrics);
+    QVERIFY(bus.registerObject(Path, &m_metrics, QDBusConnection::ExportAdaptors));
+    QVERIFY(bus.registerService(Service));
+}
+
+void MetricsTest::readAll(QVariantMap& values)
+{
+    // A connection of its own, so the call really goes through the daemon
+    QDBusConnection reader = QDBusConnection::connectToBus(QDBusConnection::SessionBus,
+                                                           QStringLiteral("reader"));
+    QVERIFY(reader.isConnected());
+
+    QDBusMessage call = QDBusMessage::createMethodCall(Service, Path,
+                                                       "org.freedesktop.DBus.Properties",
+                                                       "GetAll");
+    call << QStringLiteral("org.ustek.PlasmaClockOled.Metrics");
+
+    // The adaptor answers from this thread, so wait in the event loop
+    // instead of blocking on the reply
+    QDBusPendingCallWatcher watcher(reader.asyncCall(call));
+    QTRY_VERIFY_WITH_TIMEOUT(watcher.isFinished(), 5000);
+
+    QDBusPendingReply<QVariantMap> reply = watcher;
+    QVERIFY2(reply.isValid(), qPrintable(reply.error().message()));
+    values = reply.value();
+}
+
+void MetricsTest::properties()
+{
+    m_metrics.ticks = 1440;
+    m_metrics.jitter = {1400, 30, 10, 0, 0, 0, 0, 0};
+    m_metrics.wakeups = 1500;
+    m_metrics.wakeupRate = 1.25;
+    m_metrics.repaints = 1441;
+    m_metrics.skipped = 17;
+    m_metrics.paintNs = 250000000;
+    m_metrics.pixels = 1900000;
+    m_metrics.eventsSkipped = 12;
+    m_metrics.snapshotsSkipped = 3;
+    m_metrics.repositions = 288;
+    m_metrics.pos = QPoint(640, 4);
+
+    QVariantMap values;
+    readAll(values);
+    if (QTest::currentTestFailed()) {
+        return;
+    }
+
+    QCOMPARE(values.value("TickCount").toULongLong(), quint64(1440));
+    QCOMPARE(qdbus_cast<QList<qulonglong>>(values.value("JitterHistogram")),
+             QList<qulonglong>({1400, 30, 10, 0, 0, 0, 0, 0}));
+    QCOMPARE(qdbus_cast<QList<int>>(values.value("JitterBucketsMs")),
+             QList<int>({1, 2, 5, 10, 20, 50, 100}));
+    QCOMPARE(values.value("WakeupCount").toULongLong(), quint64(1500));
+    QCOMPARE(values.value("WakeupsPerMinute").toDouble(), 1.25);
+    QCOMPARE(values.value("RepaintCount").toULongLong(), quint64(1441));
+    QCOMPARE(values.value("RepaintsSkipped").toULongLong(), quint64(17));
+    QCOMPARE(values.value("PaintTimeMs").toDouble(), 250.0);
+    QCOMPARE(values.value("PixelsPainted").toULongLong(), quint64(1900000));
+    QCOMPARE(values.value("ConfigEventsSkipped").toULongLong(), quint64(12));
+    QCOMPARE(values.value("ConfigSnapshotsSkipped").toULongLong(), quint64(3));
+    QCOMPARE(values.value("RepositionCount").toULongLong(), quint64(288));
+    QCOMPARE(qdbus_cast<QPoint>(values.value("Position")), QPoint(640, 4));
+    QVERIFY(values.value("ResidentSetKb").toLongLong() > 0);
+}
+
+void MetricsTest::wakeupWindow()
+{
+    VirtualClock clock(QDateTime(QDate(2026, 3, 10), QTime(10, 0), QTimeZone(0)));
+    ClockSource::install(&clock);
+    Wakeups::reset();
+
+    // One wakeup a second for a minute
+    for (int i = 0; i < 60; ++i) {
+        Wakeups::record();
+        clock.advance(1000);
+    }
+    QCOMPARE(Wakeups::total(), quint64(60));
+    QCOMPARE(Wakeups::perMinute(), 60.0);
+
+    // Quiet minute: averaged over the two so far
+    clock.advance(60000);
+    QCOMPARE(Wakeups::perMinute(), 30.0);
+
+    // Once the burst is out of the window the rate drops to zero, unlike
+    // a lifetime average; the total is kept
+    clock.advance(Wakeups::WindowMs);
+    QCOMPARE(Wakeups::perMinute(), 0.0);
+    QCOMPARE(Wakeups::total(), quint64(60));
+
+    ClockSource::install(nullptr);
+    Wakeups::reset();
+}
+
+QTEST_GUILESS_MAIN(MetricsTest)
+
+#include "MetricsTest.moc"
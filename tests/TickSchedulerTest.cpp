@@ -0,0 +1,185 @@
+#include <QtTest>
+#include <memory>
+
+#include "ClockChangeNotifier.h"
+#include "ClockSource.h"
+#include "TickScheduler.h"
+
+// TickScheduler on a VirtualClock: ticks land exactly on boundaries, once
+// each, also across clock steps, DST transitions and timezone changes.
+
+static QDateTime utc(const QTime& time)
+{
+    return QDateTime(QDate(2026, 3, 10), time, QTimeZone(0));
+}
+
+class TickSchedulerTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void minuteBoundaries();
+    void secondBoundaries();
+    void stepForward();
+    void stepBackward();
+    void dstTransition();
+    void timezoneChange();
+
+private:
+    void start(const QDateTime& startTime, TickScheduler::Granularity granularity);
+    void notifyClockChanged();
+
+    std::unique_ptr<VirtualClock> m_clock;
+    std::unique_ptr<TickScheduler> m_scheduler;
+    QList<QDateTime> m_ticks;
+};
+
+void TickSchedulerTest::init()
+{
+    m_ticks.clear();
+}
+
+void TickSchedulerTest::cleanup()
+{
+    // The scheduler's timer is scheduled on the clock, destroy it first
+    m_scheduler.reset();
+    ClockSource::install(nullptr);
+    m_clock.reset();
+}
+
+void TickSchedulerTest::start(const QDateTime& startTime, TickScheduler::Granularity granularity)
+{
+    m_clock = std::make_unique<VirtualClock>(startTime);
+    ClockSource::install(m_clock.get());
+
+    m_scheduler = std::make_unique<TickScheduler>();
+    m_scheduler->setGranularity(granularity);
+    connect(m_scheduler.get(), &TickScheduler::tick, this, [this]() {
+        m_ticks.append(m_clock->now());
+    });
+    m_scheduler->start();
+}
+
+void TickSchedulerTest::notifyClockChanged()
+{
+    // What the timerfd or the /etc/localtime watch report on a real system
+    auto* notifier = m_scheduler->findChild<ClockChangeNotifier*>();
+    QVERIFY(notifier);
+    emit notifier->clockChanged();
+}
+
+void TickSchedulerTest::minuteBoundaries()
+{
+    start(utc(QTime(10, 15, 30)), TickScheduler::Minute);
+
+    m_clock->advance(29999);
+    QCOMPARE(m_ticks.size(), 0);
+    m_clock->advance(1);
+    QCOMPARE(m_ticks.size(), 1);
+    QCOMPARE(m_ticks.last().time(), QTime(10, 16));
+
+    // An hour later: one tick per minute, each exactly on the boundary
+    m_clock->advance(3600 * 1000);
+    QCOMPARE(m_ticks.size(), 61);
+    for (int i = 1; i < m_ticks.size(); i++) {
+        QCOMPARE(m_ticks[i].time().msecsSinceStartOfDay() % 60000, 0);
+        QCOMPARE(m_ticks[i - 1].msecsTo(m_ticks[i]), qint64(60000));
+    }
+
+    // No lateness in virtual time, every tick is in the first bucket
+    QCOMPARE(m_scheduler->jitterHistogram().first(), quint64(61));
+    QCOMPARE(m_scheduler->tickCount(), quint64(61));
+    QCOMPARE(m_scheduler->wakeupCount(), quint64(61));
+}
+
+void TickSchedulerTest::secondBoundaries()
+{
+    start(utc(QTime(10, 15, 30, 250)), TickScheduler::Second);
+
+    m_clock->advance(10 * 1000);
+    QCOMPARE(m_ticks.size(), 10);
+    QCOMPARE(m_ticks.first().time(), QTime(10, 15, 31));
+    QCOMPARE(m_ticks.last().time(), QTime(10, 15, 40));
+}
+
+void TickSchedulerTest::stepForward()
+{
+    start(utc(QTime(10, 15, 30)), TickScheduler::Minute);
+
+    // NTP step by 90 s: the display updates at once...
+    m_clock->step(90 * 1000);
+    notifyClockChanged();
+    QCOMPARE(m_ticks.size(), 1);
+    QCOMPARE(m_ticks.last().time(), QTime(10, 17));
+
+    // ...and the schedule follows the new time, not the old timer, which
+    // would have fired in the middle of a minute
+    m_clock->advance(59999);
+    QCOMPARE(m_ticks.size(), 1);
+    m_clock->advance(1);
+    QCOMPARE(m_ticks.size(), 2);
+    QCOMPARE(m_ticks.last().time(), QTime(10, 18));
+}
+
+void TickSchedulerTest::stepBackward()
+{
+    start(utc(QTime(10, 15, 30)), TickScheduler::Minute);
+
+    m_clock->step(-45 * 1000);
+    notifyClockChanged();
+    QCOMPARE(m_ticks.size(), 1);
+    QCOMPARE(m_ticks.last().time(), QTime(10, 14, 45));
+
+    m_clock->advance(15 * 1000);
+    QCOMPARE(m_ticks.size(), 2);
+    QCOMPARE(m_ticks.last().time(), QTime(10, 15));
+
+    m_clock->advance(60 * 1000);
+    QCOMPARE(m_ticks.size(), 3);
+    QCOMPARE(m_ticks.last().time(), QTime(10, 16));
+}
+
+void TickSchedulerTest::dstTransition()
+{
+    const QTimeZone berlin("Europe/Berlin");
+    if (!berlin.isValid()) {
+        QSKIP("No time zone data for Europe/Berlin");
+    }
+
+    // 2026-03-29 02:00 CET is 03:00 CEST
+    start(QDateTime(QDate(2026, 3, 29), QTime(1, 59, 30), berlin), TickScheduler::Minute);
+
+    m_clock->advance(30 * 1000);
+    QCOMPARE(m_ticks.size(), 1);
+    QCOMPARE(m_ticks.last().time(), QTime(3, 0));
+
+    m_clock->advance(60 * 1000);
+    QCOMPARE(m_ticks.size(), 2);
+    QCOMPARE(m_ticks.last().time(), QTime(3, 1));
+}
+
+void TickSchedulerTest::timezoneChange()
+{
+    const QTimeZone kolkata("Asia/Kolkata");
+    if (!kolkata.isValid()) {
+        QSKIP("No time zone data for Asia/Kolkata");
+    }
+
+    start(utc(QTime(10, 15, 30)), TickScheduler::Minute);
+
+    // UTC+5:30: 10:15:30 becomes 15:45:30
+    m_clock->setTimeZone(kolkata);
+    notifyClockChanged();
+    QCOMPARE(m_ticks.size(), 1);
+    QCOMPARE(m_ticks.last().time(), QTime(15, 45, 30));
+
+    m_clock->advance(30 * 1000);
+    QCOMPARE(m_ticks.size(), 2);
+    QCOMPARE(m_ticks.last().time(), QTime(15, 46));
+}
+
+QTEST_GUILESS_MAIN(TickSchedulerTest)
+#include "TickSchedulerTest.moc"